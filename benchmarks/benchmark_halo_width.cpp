@@ -0,0 +1,133 @@
+#include "discretization/donor_cell.h"
+#include "parallel/partitioning.h"
+#include "solver/sor.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/*
+ * Finds the crossover of the ghost width of the distributed SOR solver.
+ *
+ * With k ghost layers the solver exchanges the halo only every k colours, but updates
+ * the k - 1 layers that are still valid redundantly. Small subdomains are dominated by the
+ * latency of the messages and profit from a deep halo, large subdomains by the stencil updates
+ * and are slowed down by the redundant cells.
+ *
+ * For every subdomain size and ghost width the benchmark reports the wall time of one
+ * iteration (slowest rank), the number of halo exchanges per iteration and the share of
+ * redundantly updated cells.
+ *
+ * usage: mpirun -np <p> ./benchmark_halo_width [<n> ...]   with n the number of cells per direction of a subdomain
+ */
+
+/**
+ * @brief wall time of one SOR iteration on subdomains of n x n cells, maximum over all ranks
+ */
+double microsecondsPerIteration(int n, int ghostWidth, int nIterations)
+{
+  int nRanks = 1;
+  MPI_Comm_size(MPI_COMM_WORLD, &nRanks);
+  std::array<int, 2> nSubdomains = {0, 0};
+  MPI_Dims_create(nRanks, 2, nSubdomains.data());
+
+  auto partitioning = std::make_shared<Partitioning>();
+  partitioning->initialize({n * nSubdomains[0], n * nSubdomains[1]});
+  const std::array<int, 2> nCellsGlobal = partitioning->nCellsGlobal();
+  const std::array<double, 2> meshWidth = {1.0 / nCellsGlobal[0], 1.0 / nCellsGlobal[1]};
+  auto discretization = std::make_shared<DonorCell<double>>(partitioning->nCellsLocal(), meshWidth, 0.5, partitioning);
+
+  // smooth right hand side with zero mean
+  const std::array<int, 2> offset = partitioning->nodeOffset();
+  for (int j = discretization->rhsJBegin(); j < discretization->rhsJEnd(); j++)
+  {
+    for (int i = discretization->rhsIBegin(); i < discretization->rhsIEnd(); i++)
+    {
+      const double x = (offset[0] + i - 0.5) * meshWidth[0];
+      const double y = (offset[1] + j - 0.5) * meshWidth[1];
+      discretization->rhs(i, j) = std::cos(2 * M_PI * x) * std::cos(2 * M_PI * y);
+    }
+  }
+
+  // the tolerance is never reached, every solve runs nIterations iterations
+  SOR<double> solver(discretization, std::numeric_limits<double>::min(), nIterations, 1.6, ghostWidth);
+  solver.solve();
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  const double begin = MPI_Wtime();
+  solver.solve();
+  double seconds = MPI_Wtime() - begin;
+  MPI_Allreduce(MPI_IN_PLACE, &seconds, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+  return 1e6 * seconds / nIterations;
+}
+
+int main(int argc, char *argv[])
+{
+  MPI_Init(&argc, &argv);
+  int ownRankNo = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &ownRankNo);
+
+  std::vector<int> sizes = {8, 16, 32, 64, 128, 256};
+  if (argc > 1)
+  {
+    sizes.clear();
+    for (int i = 1; i < argc; i++)
+      sizes.push_back(atoi(argv[i]));
+  }
+  const std::vector<int> ghostWidths = {1, 2, 4, 8};
+
+  for (int n : sizes)
+  {
+    if (ownRankNo == 0)
+      std::cout << "subdomain n = " << n << " x " << n << " cells" << std::endl
+                << std::setw(8) << "k" << std::setw(14) << "us/iteration" << std::setw(16) << "exchanges/it"
+                << std::setw(14) << "redundant %" << std::setw(10) << "speedup" << std::endl;
+
+    // about 2^24 cell updates per measurement
+    const int nIterations = std::max(16, (1 << 24) / (n * n) / 16 * 16);
+    double reference = 0;
+    int bestGhostWidth = 1;
+    double bestTime = std::numeric_limits<double>::max();
+    for (int ghostWidth : ghostWidths)
+    {
+      if (ghostWidth > n)
+        continue;
+
+      const double time = microsecondsPerIteration(n, ghostWidth, nIterations);
+      if (ghostWidth == 1)
+        reference = time;
+      if (time < bestTime)
+      {
+        bestTime = time;
+        bestGhostWidth = ghostWidth;
+      }
+
+      // the colour s of k updates a band of k - s layers around an interior subdomain
+      double redundantCells = 0;
+      for (int depth = 1; depth < ghostWidth; depth++)
+        redundantCells += 4.0 * depth * (n + depth);
+      const double redundantShare = 100.0 * redundantCells / (double(ghostWidth) * n * n);
+
+      if (ownRankNo == 0)
+        std::cout << std::setw(8) << ghostWidth
+                  << std::setw(14) << std::fixed << std::setprecision(2) << time
+                  << std::setw(16) << std::setprecision(2) << 2.0 / ghostWidth
+                  << std::setw(14) << std::setprecision(1) << redundantShare
+                  << std::setw(10) << std::setprecision(2) << reference / time << std::endl;
+    }
+    if (ownRankNo == 0)
+      std::cout << "fastest ghost width: " << bestGhostWidth << std::endl
+                << std::endl;
+  }
+
+  MPI_Finalize();
+  return EXIT_SUCCESS;
+}
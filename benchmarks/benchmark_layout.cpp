@@ -0,0 +1,285 @@
+#include "storage/array2D.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Compares the memory layouts of Array2D (row-major, tiled, Morton) for the
+ * 5-point stencil sweeps that dominate the solver, e.g. computeD2uDy2 and the
+ * p(i, j±1) reads of the pressure solvers.
+ *
+ * For every layout and loop order the benchmark reports
+ *  - the wall time of one sweep,
+ *  - the L1 and L2 misses of a simulated cache (deterministic, available everywhere),
+ *  - the hardware cache misses from perf_event_open, if the kernel permits it.
+ *
+ * usage: ./benchmark_layout [<n> ...]   with n the number of cells per direction
+ */
+
+/**
+ * @class CacheModel
+ * @brief Set-associative cache with LRU replacement, counts misses of an address trace
+ */
+class CacheModel
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param sizeBytes capacity of the cache
+   * @param nWays associativity
+   * @param lineBytes size of a cache line
+   */
+  CacheModel(int sizeBytes, int nWays, int lineBytes) : nWays_(nWays),
+                                                         nSets_(sizeBytes / (nWays * lineBytes)),
+                                                         lineShift_(__builtin_ctz(lineBytes)),
+                                                         tags_(nSets_ * nWays, UINT64_MAX),
+                                                         lastUse_(nSets_ * nWays, 0)
+  {
+  }
+
+  /**
+   * @brief access an address, returns true on a miss
+   */
+  bool access(const void *address)
+  {
+    const uint64_t line = reinterpret_cast<uintptr_t>(address) >> lineShift_;
+    const int set = line % nSets_;
+    clock_++;
+
+    int victim = set * nWays_;
+    for (int way = set * nWays_; way < (set + 1) * nWays_; way++)
+    {
+      if (tags_[way] == line)
+      {
+        lastUse_[way] = clock_;
+        return false;
+      }
+      if (lastUse_[way] < lastUse_[victim])
+        victim = way;
+    }
+    tags_[victim] = line;
+    lastUse_[victim] = clock_;
+    misses_++;
+    return true;
+  }
+
+  //! number of misses so far
+  uint64_t misses() const
+  {
+    return misses_;
+  }
+
+private:
+  const int nWays_;               //!< associativity
+  const int nSets_;               //!< number of sets
+  const int lineShift_;           //!< log2 of the line size
+  std::vector<uint64_t> tags_;    //!< cached line per way
+  std::vector<uint64_t> lastUse_; //!< time of last access per way, for LRU
+  uint64_t clock_ = 0;            //!< access counter
+  uint64_t misses_ = 0;           //!< number of misses
+};
+
+/**
+ * @class HardwareCounter
+ * @brief Hardware performance counter of the calling thread, read via perf_event_open
+ */
+class HardwareCounter
+{
+public:
+  /**
+   * @brief Constructor, the counter is invalid if the event can not be opened
+   */
+  HardwareCounter(uint32_t type, uint64_t config)
+  {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~HardwareCounter()
+  {
+#ifdef __linux__
+    if (fd_ >= 0)
+      close(fd_);
+#endif
+  }
+
+  //! if the counter is available
+  bool valid() const
+  {
+    return fd_ >= 0;
+  }
+
+  //! reset and start counting
+  void start()
+  {
+#ifdef __linux__
+    if (!valid())
+      return;
+    ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  //! stop counting and return the count
+  long long stop()
+  {
+    long long count = -1;
+#ifdef __linux__
+    if (!valid())
+      return count;
+    ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd_, &count, sizeof(count)) != sizeof(count))
+      count = -1;
+#endif
+    return count;
+  }
+
+private:
+  int fd_ = -1; //!< file descriptor of the perf event
+};
+
+/**
+ * @brief 5-point Laplacian of src written to dst on the interior of the array
+ *
+ * @param memoryOrder if true, i is the inner loop (j outer), else j is the inner loop as in the solver
+ * @param visit called with the address of every entry that is read or written
+ */
+template <typename Layout, typename Visitor>
+void stencilSweep(Array2D<double, Layout> &src, Array2D<double, Layout> &dst, bool memoryOrder, Visitor visit)
+{
+  const int iEnd = src.size()[0] - 1;
+  const int jEnd = src.size()[1] - 1;
+
+  auto update = [&](int i, int j)
+  {
+    visit(&src(i - 1, j));
+    visit(&src(i + 1, j));
+    visit(&src(i, j - 1));
+    visit(&src(i, j + 1));
+    visit(&src(i, j));
+    visit(&dst(i, j));
+    dst(i, j) = src(i - 1, j) + src(i + 1, j) + src(i, j - 1) + src(i, j + 1) - 4.0 * src(i, j);
+  };
+
+  if (memoryOrder)
+  {
+    for (int j = 1; j < jEnd; j++)
+      for (int i = 1; i < iEnd; i++)
+        update(i, j);
+  }
+  else
+  {
+    for (int i = 1; i < iEnd; i++)
+      for (int j = 1; j < jEnd; j++)
+        update(i, j);
+  }
+}
+
+/**
+ * @brief run timing, simulated and hardware cache misses for one layout and loop order
+ */
+template <typename Layout>
+void benchmarkLayout(const std::string &name, int n, bool memoryOrder)
+{
+  const std::array<int, 2> size = {n + 2, n + 2};
+  Array2D<double, Layout> src(size);
+  Array2D<double, Layout> dst(size);
+  for (int j = 0; j < size[1]; j++)
+    for (int i = 0; i < size[0]; i++)
+      src(i, j) = i + 0.5 * j;
+
+  auto noVisit = [](const double *) {};
+
+  // warm up, then time
+  stencilSweep(src, dst, memoryOrder, noVisit);
+  const int nRepetitions = std::max(1, (1 << 24) / (n * n));
+  auto begin = std::chrono::steady_clock::now();
+  for (int repetition = 0; repetition < nRepetitions; repetition++)
+    stencilSweep(src, dst, memoryOrder, noVisit);
+  auto end = std::chrono::steady_clock::now();
+  const double msPerSweep = std::chrono::duration<double, std::milli>(end - begin).count() / nRepetitions;
+
+  // hardware counters of one sweep
+  HardwareCounter llcMisses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  HardwareCounter l1Misses(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  llcMisses.start();
+  l1Misses.start();
+  stencilSweep(src, dst, memoryOrder, noVisit);
+  const long long hwL1 = l1Misses.stop();
+  const long long hwLlc = llcMisses.stop();
+
+  // simulated cache hierarchy of one sweep: 32 KiB 8-way L1, 1 MiB 16-way L2, 64 byte lines
+  CacheModel l1(32 * 1024, 8, 64);
+  CacheModel l2(1024 * 1024, 16, 64);
+  stencilSweep(src, dst, memoryOrder, [&](const double *address)
+               {
+                 if (l1.access(address))
+                   l2.access(address);
+               });
+
+  auto hw = [](long long count)
+  {
+    return count < 0 ? std::string("n/a") : std::to_string(count);
+  };
+
+  std::cout << std::setw(10) << name
+            << std::setw(8) << (memoryOrder ? "j,i" : "i,j")
+            << std::setw(12) << std::fixed << std::setprecision(3) << msPerSweep
+            << std::setw(14) << l1.misses()
+            << std::setw(14) << l2.misses()
+            << std::setw(14) << hw(hwL1)
+            << std::setw(14) << hw(hwLlc) << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  std::vector<int> sizes = {256, 1024, 2048};
+  if (argc > 1)
+  {
+    sizes.clear();
+    for (int i = 1; i < argc; i++)
+      sizes.push_back(atoi(argv[i]));
+  }
+
+  for (int n : sizes)
+  {
+    std::cout << "n = " << n << " x " << n << " cells" << std::endl
+              << std::setw(10) << "layout" << std::setw(8) << "loops" << std::setw(12) << "ms/sweep"
+              << std::setw(14) << "sim L1 miss" << std::setw(14) << "sim L2 miss"
+              << std::setw(14) << "hw L1 miss" << std::setw(14) << "hw LLC miss" << std::endl;
+
+    for (bool memoryOrder : {true, false})
+    {
+      benchmarkLayout<RowMajorLayout>("row-major", n, memoryOrder);
+      benchmarkLayout<TiledLayout<>>("tiled", n, memoryOrder);
+      benchmarkLayout<MortonLayout>("morton", n, memoryOrder);
+    }
+    std::cout << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
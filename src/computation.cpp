@@ -1,6 +1,7 @@
 #include "computation.h"
 
-void Computation::initialize(int argc, char *argv[])
+template <typename T, typename A>
+void Computation<T, A>::initialize(int argc, char *argv[])
 {
 
     std::string filename = argv[1];
@@ -8,45 +9,143 @@ void Computation::initialize(int argc, char *argv[])
     // load settings from file
     settings_.loadFromFile(filename);
 #ifndef NDEBUG
-    settings_.printSettings();
+    int rankNo = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rankNo);
+    if (rankNo == 0)
+        settings_.printSettings();
 #endif
 
     std::array<double, 2> meshWidth_ = {settings_.physicalSize[0] / settings_.nCells[0],
                                         settings_.physicalSize[1] / settings_.nCells[1]};
 
+    // threads of the own rank, the loops touch up to four field variables per cell
+    threadPool_ = std::make_unique<ThreadPool>(settings_.nThreads, settings_.pinThreads, 4 * sizeof(T));
+
+    // the field variables are allocated afterwards and first touched by these threads
+    FieldAllocation::useHugePages = settings_.useHugePages;
+
+    // decompose the domain, the discretization only holds the own subdomain
+    partitioning_ = std::make_shared<Partitioning>();
+    partitioning_->initialize(settings_.nCells);
+    const std::array<int, 2> nCellsLocal = partitioning_->nCellsLocal();
+
     if (settings_.useDonorCell)
     {
-        discretization_ = std::make_shared<DonorCell>(settings_.nCells, meshWidth_, settings_.alpha);
+        discretization_ = std::make_shared<DonorCell<T, A>>(nCellsLocal, meshWidth_, settings_.alpha, partitioning_);
     }
     else
     {
-        discretization_ = std::make_shared<CentralDifferences>(settings_.nCells, meshWidth_);
+        discretization_ = std::make_shared<CentralDifferences<T, A>>(nCellsLocal, meshWidth_, partitioning_);
     }
+    haloExchange_ = std::make_unique<HaloExchange<T>>(partitioning_);
+    stepReduction_ = std::make_unique<ReductionBatch>(partitioning_);
+
+    // the halo exchange of F and G is begun by the task that completes the last sent cells
+    int threadSupport = MPI_THREAD_SINGLE;
+    MPI_Query_thread(&threadSupport);
+    communicateInTasks_ = threadSupport >= MPI_THREAD_SERIALIZED;
 
     if (settings_.pressureSolver == "SOR")
     {
-        pressureSolver_ = std::make_unique<SOR>(discretization_,
-                                                settings_.epsilon,
-                                                settings_.maximumNumberOfIterations,
-                                                settings_.omega);
+        pressureSolver_ = std::make_unique<SOR<T, A>>(discretization_,
+                                                      settings_.epsilon,
+                                                      settings_.maximumNumberOfIterations,
+                                                      settings_.omega,
+                                                      settings_.haloWidth);
+    }
+    else
+    {
+        pressureSolver_ = std::make_unique<GaussSeidel<T, A>>(discretization_,
+                                                              settings_.epsilon,
+                                                              settings_.maximumNumberOfIterations,
+                                                              settings_.haloWidth);
     }
+
+    // the values are stored in the output precision, lossy compression rounds values of double precision
+    const VtiFile::Precision precision = VtiFile::precisionFromName(settings_.paraviewPrecision);
+    if (settings_.paraviewCompression == "lossy" && precision != VtiFile::Precision::float64)
+        throw std::invalid_argument("The lossy paraviewCompression needs paraviewPrecision = float64.");
+
+    // the pieces contain the nodes on the edges to their neighbours, in the shared file they belong to the upper neighbour
+    if (settings_.paraviewOutput == "shared")
+        outputWriterParaview_ = std::make_unique<OutputWriterMpiIo<T>>(discretization_,
+                                                                       NodeSelection(*partitioning_, discretization_->meshWidth(),
+                                                                                     settings_.paraviewRegion, settings_.paraviewStride, false),
+                                                                       precision);
+    else if (settings_.paraviewOutput == "stream")
+        outputWriterParaview_ = std::make_unique<OutputWriterStream<T>>(discretization_,
+                                                                        NodeSelection(*partitioning_, discretization_->meshWidth(),
+                                                                                      settings_.paraviewRegion, settings_.paraviewStride, false),
+                                                                        precision, settings_.paraviewKeyframeInterval);
+#ifdef NUMSIM_HAVE_VTK
+    else if (settings_.paraviewOutput == "vtk")
+    {
+        if (precision != VtiFile::Precision::float64 && partitioning_->ownRankNo() == 0)
+            std::cout << "paraviewPrecision is not applied to the pieces written with VTK, they are written as Float64." << std::endl;
+        if ((!settings_.paraviewRegion.empty() || settings_.paraviewStride != 1) && partitioning_->ownRankNo() == 0)
+            std::cout << "paraviewRegion and paraviewStride are not applied to the pieces written with VTK, they contain all nodes." << std::endl;
+        outputWriterParaview_ = std::make_unique<OutputWriterParaviewParallel<T>>(discretization_);
+    }
+#endif
     else
     {
-        pressureSolver_ = std::make_unique<GaussSeidel>(discretization_,
-                                                        settings_.epsilon,
-                                                        settings_.maximumNumberOfIterations);
+        if (settings_.paraviewOutput == "vtk" && partitioning_->ownRankNo() == 0)
+            std::cout << "numsim is built without VTK, the pieces are written without it." << std::endl;
+        outputWriterParaview_ = std::make_unique<OutputWriterVti<T>>(discretization_,
+                                                                     NodeSelection(*partitioning_, discretization_->meshWidth(),
+                                                                                   settings_.paraviewRegion, settings_.paraviewStride),
+                                                                     precision,
+                                                                     BlockCodec(BlockCodec::methodFromName(settings_.paraviewCompression),
+                                                                                settings_.paraviewTolerance));
     }
+    if (settings_.paraviewCompression != "none" && settings_.paraviewOutput != "pieces" && settings_.paraviewOutput != "stream" && partitioning_->ownRankNo() == 0)
+        std::cout << "paraviewCompression is only applied to the pieces, the vti files are written uncompressed." << std::endl;
+    if (settings_.paraviewCompression != "none" && settings_.paraviewOutput == "stream" && partitioning_->ownRankNo() == 0)
+        std::cout << "paraviewCompression is not applied to the stream, its frames are always encoded losslessly." << std::endl;
+
+    // the change is measured at the nodes in paraviewRegion, also for the VTK writer that writes all nodes
+    if (settings_.paraviewChangeThreshold > 0)
+        outputWriterParaview_ = std::make_unique<OutputWriterOnChange<T>>(discretization_, std::move(outputWriterParaview_),
+                                                                          NodeSelection(*partitioning_, discretization_->meshWidth(),
+                                                                                        settings_.paraviewRegion, settings_.paraviewStride),
+                                                                          settings_.paraviewChangeThreshold);
+
+    // the output is written on an I/O thread, the writers that communicate can only run there if MPI allows concurrent calls
+    const bool writerCommunicates = settings_.paraviewOutput == "shared" || settings_.paraviewOutput == "stream" || precision == VtiFile::Precision::quantized16 ||
+                                    settings_.paraviewChangeThreshold > 0;
+    if (settings_.asyncOutput && (!writerCommunicates || threadSupport >= MPI_THREAD_MULTIPLE))
+        outputWriterParaview_ = std::make_unique<OutputWriterAsync<T>>(discretization_, std::move(outputWriterParaview_), threadPool_->ioCores(),
+                                                                       threadPool_->nIoThreads());
+    outputWriterText_ = std::make_unique<OutputWriterTextParallel<T>>(discretization_);
+    if (!settings_.probes.empty())
+        outputWriterProbes_ = std::make_unique<OutputWriterProbes<T>>(discretization_, settings_.probes);
+
+    paraviewSchedule_ = OutputSchedule(settings_.paraviewCadence);
+    textSchedule_ = OutputSchedule(settings_.textCadence);
+    if (outputWriterProbes_)
+        probeSchedule_ = OutputSchedule(settings_.probeCadence);
+
+    // the change of the velocities is only computed if an output waits for the steady state
+    detectSteadyState_ = settings_.paraviewCadence.onSteadyState || settings_.probeCadence.onSteadyState;
+#ifndef NDEBUG
+    detectSteadyState_ = detectSteadyState_ || settings_.textCadence.onSteadyState;
+#endif
 
-    outputWriterParaview_ = std::make_unique<OutputWriterParaview>(discretization_);
-    outputWriterText_ = std::make_unique<OutputWriterText>(discretization_);
+    // the velocities start at zero, the boundary values are added in computeTimeStepWidth
+    uMax_ = 0;
+    vMax_ = 0;
+    velocityChange_ = std::numeric_limits<double>::infinity();
+    steadyStateReached_ = false;
+    beginStepReduction();
 }
 
-void Computation::runSimulation()
+template <typename T, typename A>
+void Computation<T, A>::runSimulation()
 {
     double currentTime = 0.;
+    int stepNo = 0;
     do
     {
-        applyBoundaryValues();
         computeTimeStepWidth(currentTime);
         computePreliminaryVelocities();
         computeRightHandSide();
@@ -54,18 +153,46 @@ void Computation::runSimulation()
         computeVelocities();
 
         currentTime += dt_;
+        stepNo++;
+
+        writeOutput(currentTime, stepNo);
+
+#ifndef NDEBUG
+        if (partitioning_->ownRankNo() == 0)
+            std::cout << currentTime << std::endl;
+#endif
+
+    } while (currentTime < settings_.endTime);
+}
+
+template <typename T, typename A>
+void Computation<T, A>::writeOutput(double currentTime, int stepNo)
+{
+    // every schedule is asked once per time step, the steady state event is only taken once
+    const bool isParaviewDue = paraviewSchedule_.isDue(currentTime, stepNo, steadyStateReached_);
+    const bool isProbeDue = probeSchedule_.isDue(currentTime, stepNo, steadyStateReached_);
+
+    // the pressure solver does not exchange the corners of the ghost layer, the values at the
+    // nodes on the corners of the subdomain are interpolated from them
+    if (isParaviewDue || isProbeDue)
+        haloExchange_->exchange(discretization_->p());
+
+    if (isParaviewDue)
         outputWriterParaview_->writeFile(currentTime);
+    if (isProbeDue)
+        outputWriterProbes_->writeFile(currentTime);
 
 #ifndef NDEBUG
+    if (textSchedule_.isDue(currentTime, stepNo, steadyStateReached_))
+    {
         outputWriterText_->writeFile(currentTime);
         outputWriterText_->writePressureFile();
-        std::cout << currentTime << std::endl;
+    }
 #endif
-
-    } while (currentTime < settings_.endTime);
 }
 
-void Computation::applyBoundaryValues()
+template <typename T, typename A>
+void Computation<T, A>::applyBoundaryValuesU()
 {
 
     // set Dirichlet BC
@@ -76,139 +203,258 @@ void Computation::applyBoundaryValues()
     int j_beg = discretization_->uJBegin();
     int j_end = discretization_->uJEnd();
 
+    // only the ranks on the boundary of the domain set boundary values, the other ghost values are exchanged
+    const bool left = partitioning_->ownPartitionContainsLeftBoundary();
+    const bool right = partitioning_->ownPartitionContainsRightBoundary();
+    const bool bottom = partitioning_->ownPartitionContainsBottomBoundary();
+    const bool top = partitioning_->ownPartitionContainsTopBoundary();
+
     // Vertical
     for (int j = j_beg; j < j_end; j++)
     {
-        discretization_->u(i_beg, j) = settings_.dirichletBcLeft[0];
-        discretization_->u(i_end - 1, j) = settings_.dirichletBcRight[0];
+        if (left)
+            discretization_->u(i_beg, j) = settings_.dirichletBcLeft[0];
+        if (right)
+            discretization_->u(i_end - 1, j) = settings_.dirichletBcRight[0];
     }
     // Horizontal (leave out corners)
     for (int i = i_beg + 1; i < i_end - 1; i++)
     {
-        discretization_->u(i, j_beg) = 2 * settings_.dirichletBcBottom[0] - discretization_->u(i, j_beg + 1);
-        discretization_->u(i, j_end - 1) = 2 * settings_.dirichletBcTop[0] - discretization_->u(i, j_end - 2);
+        if (bottom)
+            discretization_->u(i, j_beg) = 2 * settings_.dirichletBcBottom[0] - discretization_->u(i, j_beg + 1);
+        if (top)
+            discretization_->u(i, j_end - 1) = 2 * settings_.dirichletBcTop[0] - discretization_->u(i, j_end - 2);
     }
+}
 
+template <typename T, typename A>
+void Computation<T, A>::applyBoundaryValuesV()
+{
     // BV for v
-    i_beg = discretization_->vIBegin();
-    i_end = discretization_->vIEnd();
-    j_beg = discretization_->vJBegin();
-    j_end = discretization_->vJEnd();
+    int i_beg = discretization_->vIBegin();
+    int i_end = discretization_->vIEnd();
+    int j_beg = discretization_->vJBegin();
+    int j_end = discretization_->vJEnd();
+
+    // only the ranks on the boundary of the domain set boundary values, the other ghost values are exchanged
+    const bool left = partitioning_->ownPartitionContainsLeftBoundary();
+    const bool right = partitioning_->ownPartitionContainsRightBoundary();
+    const bool bottom = partitioning_->ownPartitionContainsBottomBoundary();
+    const bool top = partitioning_->ownPartitionContainsTopBoundary();
 
     // Vertical
     for (int j = j_beg; j < j_end; j++)
     {
-        discretization_->v(i_beg, j) = 2 * settings_.dirichletBcLeft[1] - discretization_->v(i_beg + 1, j);
-        discretization_->v(i_end - 1, j) = 2 * settings_.dirichletBcRight[1] - discretization_->v(i_end - 2, j);
+        if (left)
+            discretization_->v(i_beg, j) = 2 * settings_.dirichletBcLeft[1] - discretization_->v(i_beg + 1, j);
+        if (right)
+            discretization_->v(i_end - 1, j) = 2 * settings_.dirichletBcRight[1] - discretization_->v(i_end - 2, j);
     }
     // Horizontal (leave out corners)
     for (int i = i_beg + 1; i < i_end - 1; i++)
     {
-        discretization_->v(i, j_beg) = settings_.dirichletBcBottom[1];
-        discretization_->v(i, j_end - 1) = settings_.dirichletBcTop[1];
+        if (bottom)
+            discretization_->v(i, j_beg) = settings_.dirichletBcBottom[1];
+        if (top)
+            discretization_->v(i, j_end - 1) = settings_.dirichletBcTop[1];
     }
 }
 
-void Computation::computeTimeStepWidth(double currentTime)
+template <typename T, typename A>
+void Computation<T, A>::computeTimeStepWidth(double currentTime)
 {
     // Diffusion operator (always > 0)
     double dx2 = discretization_->dx() * discretization_->dx();
     double dy2 = discretization_->dy() * discretization_->dy();
     double diff = settings_.re / 2 * (dx2 * dy2) / (dx2 + dy2);
 
+    // maxima accumulated in computeVelocities over all subdomains, the reduction has been in flight since then
+    stepReduction_->finish();
+
+    // the velocities on the walls are the Dirichlet values, the ghost values do not enter the CFL condition
+    std::array<double, 2> velocityMax;
+    velocityMax[0] = std::max({stepReduction_->value(uMaxEntry_),
+                               std::abs(settings_.dirichletBcLeft[0]), std::abs(settings_.dirichletBcRight[0]),
+                               std::abs(settings_.dirichletBcBottom[0]), std::abs(settings_.dirichletBcTop[0])});
+    velocityMax[1] = std::max({stepReduction_->value(vMaxEntry_),
+                               std::abs(settings_.dirichletBcLeft[1]), std::abs(settings_.dirichletBcRight[1]),
+                               std::abs(settings_.dirichletBcBottom[1]), std::abs(settings_.dirichletBcTop[1])});
+
     // convection operator restriction u
-    double max_u = discretization_->dx() / discretization_->u().findAbsMax();
+    double max_u = discretization_->dx() / velocityMax[0];
 
     // convection operator restriction v
-    double max_v = discretization_->dy() / discretization_->v().findAbsMax();
+    double max_v = discretization_->dy() / velocityMax[1];
 
     dt_ = settings_.tau * std::min({diff, max_u, max_v, settings_.maximumDt});
 
+    // end the time step on the next output time, so that the output shows the solution at that time,
+    // the debugging output does not change the time steps of debug builds
+    dt_ = paraviewSchedule_.clampTimeStepWidth(currentTime, dt_);
+    dt_ = probeSchedule_.clampTimeStepWidth(currentTime, dt_);
+
+    // the velocities are steady if they changed less than the tolerance in the previous time step
+    steadyStateReached_ = detectSteadyState_ && stepReduction_->value(velocityChangeEntry_) < settings_.steadyStateTolerance;
+
     if (currentTime + dt_ > settings_.endTime)
     {
         dt_ = settings_.endTime - currentTime;
     }
 }
 
-void Computation::computePreliminaryVelocities()
+template <typename T, typename A>
+void Computation<T, A>::computePreliminaryVelocities()
 {
-    // ****************************************
-    // Compute F
-    // ****************************************
+    // dispatch once on the scheme, so that its stencils can be inlined into the loops
+    if (settings_.useDonorCell)
+    {
+        computePreliminaryVelocities(static_cast<const DonorCell<T, A> &>(*discretization_));
+    }
+    else
+    {
+        computePreliminaryVelocities(static_cast<const CentralDifferences<T, A> &>(*discretization_));
+    }
+}
+
+template <typename T, typename A>
+template <typename Scheme>
+void Computation<T, A>::computePreliminaryVelocities(const Scheme &scheme)
+{
+    // views on the field variables for the hot loops
+    const FieldView<const T> u = scheme.u().view();
+    const FieldView<const T> v = scheme.v().view();
+    const FieldView<T> f = discretization_->f().view();
+    const FieldView<T> g = discretization_->g().view();
+    const A reInv = A(1 / settings_.re);
+    const A dt = A(dt_);
+    const A gx = A(settings_.g[0]);
+    const A gy = A(settings_.g[1]);
+
     int f_i_beg = discretization_->fIBegin();
     int f_i_end = discretization_->fIEnd();
     int f_j_beg = discretization_->fJBegin();
     int f_j_end = discretization_->fJEnd();
 
-    // Boundary of F
+    int g_i_beg = discretization_->gIBegin();
+    int g_i_end = discretization_->gIEnd();
+    int g_j_beg = discretization_->gJBegin();
+    int g_j_end = discretization_->gJEnd();
 
-    // Vertical
-    for (int j = f_j_beg - 1; j < f_j_end + 1; j++)
-    {
-        discretization_->f(f_i_beg, j) = discretization_->u(f_i_beg, j);
-        discretization_->f(f_i_end - 1, j) = discretization_->u(f_i_end - 1, j);
-    }
+    // ****************************************
+    // Boundary of F and G
+    // ****************************************
 
-    // Horizontal
-    for (int i = f_i_beg; i < f_i_end + 1; i++)
+    // only on the boundary of the domain, the faces to the neighbours are exchanged
+    auto computeBoundaryF = [&]()
     {
-        discretization_->f(i, f_j_beg - 1) = discretization_->u(i, f_j_beg - 1);
-        // std::cout << discretization_->u(i, f_j_beg) << std::endl;
-        discretization_->f(i, f_j_end) = discretization_->u(i, f_j_end);
-    }
+        // F vertical
+        for (int j = f_j_beg - 1; j < f_j_end + 1; j++)
+        {
+            if (partitioning_->ownPartitionContainsLeftBoundary())
+                discretization_->f(f_i_beg, j) = discretization_->u(f_i_beg, j);
+            if (partitioning_->ownPartitionContainsRightBoundary())
+                discretization_->f(f_i_end - 1, j) = discretization_->u(f_i_end - 1, j);
+        }
+
+        // F horizontal
+        for (int i = 0; i < discretization_->f().size()[0]; i++)
+        {
+            if (partitioning_->ownPartitionContainsBottomBoundary())
+                discretization_->f(i, f_j_beg - 1) = discretization_->u(i, f_j_beg - 1);
+            if (partitioning_->ownPartitionContainsTopBoundary())
+                discretization_->f(i, f_j_end) = discretization_->u(i, f_j_end);
+        }
+    };
 
-    // Interior
-    for (int i = f_i_beg + 1; i < f_i_end - 1; i++)
+    auto computeBoundaryG = [&]()
     {
-        for (int j = f_j_beg; j < f_j_end; j++)
+        // G horizontal
+        for (int i = g_i_beg - 1; i < g_i_end + 1; i++)
         {
+            if (partitioning_->ownPartitionContainsBottomBoundary())
+                discretization_->g(i, g_j_beg) = discretization_->v(i, g_j_beg);
+            if (partitioning_->ownPartitionContainsTopBoundary())
+                discretization_->g(i, g_j_end - 1) = discretization_->v(i, g_j_end - 1);
+        }
 
-            double diffusion = 1 / settings_.re * (discretization_->computeD2uDx2(i, j) + discretization_->computeD2uDy2(i, j));
-            double convection = -discretization_->computeDu2Dx(i, j) - discretization_->computeDuvDy(i, j);
-            discretization_->f(i, j) = discretization_->u(i, j) + dt_ * (diffusion + convection + settings_.g[0]);
+        // G vertical
+        for (int j = 0; j < discretization_->g().size()[1]; j++)
+        {
+            if (partitioning_->ownPartitionContainsLeftBoundary())
+                discretization_->g(g_i_beg - 1, j) = discretization_->v(g_i_beg - 1, j);
+            if (partitioning_->ownPartitionContainsRightBoundary())
+                discretization_->g(g_i_end, j) = discretization_->v(g_i_end, j);
         }
-    }
+    };
 
     // ****************************************
-    // Compute G
+    // Interior of F and G
     // ****************************************
 
-    int g_i_beg = discretization_->gIBegin();
-    int g_i_end = discretization_->gIEnd();
-    int g_j_beg = discretization_->gJBegin();
-    int g_j_end = discretization_->gJEnd();
+    auto computeF = [&](int i, int j)
+    {
+        A diffusion = reInv * (scheme.computeD2uDx2(u, i, j) + scheme.computeD2uDy2(u, i, j));
+        A convection = -scheme.computeDu2Dx(u, i, j) - scheme.computeDuvDy(u, v, i, j);
+        f(i, j) = u(i, j) + dt * (diffusion + convection + gx);
+    };
+    auto computeG = [&](int i, int j)
+    {
+        A diffusion = reInv * (scheme.computeD2vDx2(v, i, j) + scheme.computeD2vDy2(v, i, j));
+        A convection = -scheme.computeDv2Dy(v, i, j) - scheme.computeDuvDx(u, v, i, j);
+        g(i, j) = v(i, j) + dt * (diffusion + convection + gy);
+    };
+    const IndexRange fInterior = {f_i_beg + 1, f_i_end - 1, f_j_beg, f_j_end};
+    const IndexRange gInterior = {g_i_beg, g_i_end, g_j_beg + 1, g_j_end - 1};
+
+    auto beginExchange = [&]()
+    {
+        haloExchange_->begin(discretization_->f());
+        haloExchange_->begin(discretization_->g());
+    };
 
-    // Boundary of G
+    // ****************************************
+    // Graph of the time step
+    // ****************************************
 
-    // Horizontal
-    for (int i = g_i_beg - 1; i < g_i_end + 1; i++)
+    TaskGraph graph;
+    const int uBoundary = graph.add([&]()
+                                    { applyBoundaryValuesU(); });
+    const int vBoundary = graph.add([&]()
+                                    { applyBoundaryValuesV(); });
+
+    // the boundaries of F and G copy the boundary values of u and v
+    std::vector<int> sent = {graph.add(computeBoundaryF, {uBoundary}),
+                             graph.add(computeBoundaryG, {vBoundary})};
+
+    // the right hand side needs F and G on the faces to the left and bottom neighbours, the cells
+    // next to the neighbours read the boundary values and are sent as soon as they are computed
+    for (const IndexRange &strip : boundaryStrips(fInterior, 1))
     {
-        discretization_->g(i, g_j_beg) = discretization_->v(i, g_j_beg);
-        discretization_->g(i, g_j_end - 1) = discretization_->v(i, g_j_end - 1);
+        for (int tile : graph.addForEach(strip, computeF, {uBoundary, vBoundary}))
+            sent.push_back(tile);
     }
-
-    // Vertical
-    for (int j = g_j_beg; j < g_j_end + 1; j++)
+    for (const IndexRange &strip : boundaryStrips(gInterior, 1))
     {
-        discretization_->g(g_i_beg - 1, j) = discretization_->v(g_i_beg - 1, j);
-        discretization_->g(g_i_end, j) = discretization_->v(g_i_end, j);
+        for (int tile : graph.addForEach(strip, computeG, {uBoundary, vBoundary}))
+            sent.push_back(tile);
     }
+    if (communicateInTasks_)
+        graph.add(beginExchange, sent);
 
-    // Interior
-    for (int i = g_i_beg; i < g_i_end; i++)
-    {
-        for (int j = g_j_beg + 1; j < g_j_end - 1; j++)
-        {
+    // the stencils of the inner cells only read the interior of u and v, which the boundary values do not change
+    graph.addForEach(innerRange(fInterior, 1), computeF);
+    graph.addForEach(innerRange(gInterior, 1), computeG);
 
-            double diffusion = 1 / settings_.re * (discretization_->computeD2vDx2(i, j) + discretization_->computeD2vDy2(i, j));
-            double convection = -discretization_->computeDv2Dy(i, j) - discretization_->computeDuvDx(i, j);
+    graph.run();
 
-            discretization_->g(i, j) = discretization_->v(i, j) + dt_ * (diffusion + convection + settings_.g[1]);
-        }
-    }
+    // without MPI support for threads the master begins the exchange, after all cells are computed
+    if (!communicateInTasks_)
+        beginExchange();
+    haloExchange_->finish();
 }
 
-void Computation::computeRightHandSide()
+template <typename T, typename A>
+void Computation<T, A>::computeRightHandSide()
 {
 
     int i_beg = discretization_->rhsIBegin();
@@ -216,39 +462,127 @@ void Computation::computeRightHandSide()
     int j_beg = discretization_->rhsJBegin();
     int j_end = discretization_->rhsJEnd();
 
-    // Interior
-    for (int i = i_beg; i < i_end; i++)
+    const FieldView<const T> f = std::as_const(*discretization_).f().view();
+    const FieldView<const T> g = std::as_const(*discretization_).g().view();
+    const FieldView<T> rhs = discretization_->rhs().view();
+    const A dxInv = A(1 / discretization_->dx());
+    const A dyInv = A(1 / discretization_->dy());
+    const A dtInv = A(1 / dt_);
+
+    // value of a cell from f at the cell and left of it and g at the cell and below it
+    auto divergence = [=](T fCentre, T fLeft, T gCentre, T gBottom) -> T
     {
-        for (int j = j_beg; j < j_end; j++)
-        {
-            double dF = (1 / discretization_->dx()) * (discretization_->f(i, j) - discretization_->f(i - 1, j));
-            double dG = (1 / discretization_->dy()) * (discretization_->g(i, j) - discretization_->g(i, j - 1));
-            discretization_->rhs(i, j) = (1 / dt_) * (dF + dG);
-        }
+        A dF = dxInv * (A(fCentre) - fLeft);
+        A dG = dyInv * (A(gCentre) - gBottom);
+        return dtInv * (dF + dG);
+    };
+
+    // Interior, the rows of the row-major layout are passed as restrict-qualified pointers
+    if constexpr (FieldView<T>::hasRows)
+    {
+        const int stride = g.stride();
+        forEachInterior({i_beg, i_end, j_beg, j_end}, onRows([=](int i, const T *fRow, const T *gRow, T *rhsRow)
+                                                             { rhsRow[i] = divergence(fRow[i], fRow[i - 1], gRow[i], gRow[i - stride]); },
+                                                             f, g, rhs),
+                        IterationPolicy::independent());
+    }
+    else
+    {
+        forEachInterior({i_beg, i_end, j_beg, j_end}, [&](int i, int j)
+                        { rhs(i, j) = divergence(f(i, j), f(i - 1, j), g(i, j), g(i, j - 1)); },
+                        IterationPolicy::independent());
     }
 }
 
-void Computation::computePressure()
+template <typename T, typename A>
+void Computation<T, A>::computePressure()
 {
     pressureSolver_->solve();
 }
 
-void Computation::computeVelocities()
+template <typename T, typename A>
+void Computation<T, A>::computeVelocities()
 {
+    const FieldView<const T> f = std::as_const(*discretization_).f().view();
+    const FieldView<const T> g = std::as_const(*discretization_).g().view();
+    const FieldView<const T> p = std::as_const(*discretization_).p().view();
+    const FieldView<T> u = discretization_->u().view();
+    const FieldView<T> v = discretization_->v().view();
 
-    for (int i = discretization_->uIBegin() + 1; i < discretization_->uIEnd() - 1; i++)
+    const A dt = A(dt_);
+    const Discretization<T, A> &discretization = *discretization_;
+
+    auto maximum = [](double a, double b)
     {
-        for (int j = discretization_->uJBegin() + 1; j < discretization_->uJEnd() - 1; j++)
-        {
-            discretization_->u(i, j) = discretization_->f(i, j) - dt_ * discretization_->computeDpDx(i, j);
-        }
-    }
+        return std::max(a, b);
+    };
 
-    for (int i = discretization_->vIBegin() + 1; i < discretization_->vIEnd() - 1; i++)
+    auto computeU = [&](int i, int j)
+    {
+        const T value = f(i, j) - dt * discretization.computeDpDx(p, i, j);
+        u(i, j) = value;
+        return std::abs(double(value));
+    };
+    auto computeV = [&](int i, int j)
     {
-        for (int j = discretization_->vJBegin() + 1; j < discretization_->vJEnd() - 1; j++)
+        const T value = g(i, j) - dt * discretization.computeDpDy(p, i, j);
+        v(i, j) = value;
+        return std::abs(double(value));
+    };
+    const IndexRange uInterior = {discretization.uIBegin() + 1, discretization.uIEnd() - 1,
+                                  discretization.uJBegin() + 1, discretization.uJEnd() - 1};
+    const IndexRange vInterior = {discretization.vIBegin() + 1, discretization.vIEnd() - 1,
+                                  discretization.vJBegin() + 1, discretization.vJEnd() - 1};
+
+    // rate of change of the velocities for the steady state output, before they are overwritten
+    if (detectSteadyState_)
+    {
+        auto changeU = [&](int i, int j)
         {
-            discretization_->v(i, j) = discretization_->g(i, j) - dt_ * discretization_->computeDpDy(i, j);
-        }
+            return std::abs(double(f(i, j) - dt * discretization.computeDpDx(p, i, j) - u(i, j)));
+        };
+        auto changeV = [&](int i, int j)
+        {
+            return std::abs(double(g(i, j) - dt * discretization.computeDpDy(p, i, j) - v(i, j)));
+        };
+        velocityChange_ = std::max(reduceInterior(uInterior, 0.0, changeU, maximum, IterationPolicy::independent()),
+                                   reduceInterior(vInterior, 0.0, changeV, maximum, IterationPolicy::independent())) /
+                          dt_;
     }
+
+    // update the interior and accumulate the maximum velocities for the next time step width,
+    // the cells next to the neighbours are updated first and sent while the inner cells are updated
+    uMax_ = 0;
+    vMax_ = 0;
+    for (const IndexRange &strip : boundaryStrips(uInterior, 1))
+        uMax_ = std::max(uMax_, reduceInterior(strip, 0.0, computeU, maximum, IterationPolicy::independent()));
+    for (const IndexRange &strip : boundaryStrips(vInterior, 1))
+        vMax_ = std::max(vMax_, reduceInterior(strip, 0.0, computeV, maximum, IterationPolicy::independent()));
+
+    // ghost layers for the next time step
+    haloExchange_->begin(discretization_->u());
+    haloExchange_->begin(discretization_->v());
+
+    uMax_ = std::max(uMax_, reduceInterior(innerRange(uInterior, 1), 0.0, computeU, maximum, IterationPolicy::independent()));
+    vMax_ = std::max(vMax_, reduceInterior(innerRange(vInterior, 1), 0.0, computeV, maximum, IterationPolicy::independent()));
+
+    haloExchange_->finish();
+    beginStepReduction();
+}
+
+template <typename T, typename A>
+void Computation<T, A>::beginStepReduction()
+{
+    // all global scalars of the time step in one message, in flight during the output and the boundary values
+    stepReduction_->clear();
+    uMaxEntry_ = stepReduction_->add(uMax_, ReductionBatch::Operation::max);
+    vMaxEntry_ = stepReduction_->add(vMax_, ReductionBatch::Operation::max);
+    if (detectSteadyState_)
+        velocityChangeEntry_ = stepReduction_->add(velocityChange_, ReductionBatch::Operation::max);
+    stepReduction_->begin();
 }
+
+// storage and accumulation types: double, float and mixed precision
+template class Computation<double, double>;
+template class Computation<float, float>;
+template class Computation<float, double>;
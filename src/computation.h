@@ -8,20 +8,46 @@
 #include "solver/sor.h"
 #include "solver/gauss_seidel.h"
 
-#include "output_writer/output_writer_paraview.h"
-#include "output_writer/output_writer_text.h"
+#ifdef NUMSIM_HAVE_VTK
+#include "output_writer/output_writer_paraview_parallel.h"
+#endif
+#include "output_writer/output_writer_text_parallel.h"
+#include "output_writer/output_writer_vti.h"
+#include "output_writer/output_writer_mpi_io.h"
+#include "output_writer/output_writer_async.h"
+#include "output_writer/output_writer_on_change.h"
+#include "output_writer/output_writer_stream.h"
+#include "output_writer/output_writer_probes.h"
+#include "output_writer/output_schedule.h"
+#include "parallel/partitioning.h"
+#include "parallel/halo_exchange.h"
+#include "parallel/reduction_batch.h"
+#include "parallel/task_graph.h"
+#include "parallel/thread_pool.h"
 #include "settings_parser/settings.h"
+#include "storage/iteration.h"
 
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
 
 /**
  * @class Computation
  * @brief Computation of Simulation
  *
  * Combines discretization, pressure solver and outputwriter
+ *
+ * Every MPI rank computes one subdomain of the partitioning, the ghost layers
+ * are exchanged after the velocities and the preliminary velocities are updated.
+ * The boundary values and the preliminary velocities of a time step are one graph of tasks.
+ *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which derivatives and stencil updates are evaluated
  */
+template <typename T = double, typename A = T>
 class Computation
 {
 public:
@@ -48,15 +74,33 @@ private:
     void computeTimeStepWidth(double currentTime);
 
     /**
-     * @brief Set boundary values of u and v to correct values
+     * @brief Set boundary values of u to correct values
+     */
+    void applyBoundaryValuesU();
+
+    /**
+     * @brief Set boundary values of v to correct values
      */
-    void applyBoundaryValues();
+    void applyBoundaryValuesV();
 
     /**
-     * @brief Compute the preliminary velocities F and G
+     * @brief Set the boundary values of u and v and compute the preliminary velocities F and G
      */
     void computePreliminaryVelocities();
 
+    /**
+     * @brief Set the boundary values of u and v and compute the preliminary velocities F and G
+     *        with the derivatives of the given scheme
+     *
+     * The boundary values, the boundaries of F and G and the tiles of their interiors are tasks of one graph.
+     * A task only waits for the tasks whose results it reads, the halo exchange of F and G is begun
+     * by a task as soon as the cells it sends are computed.
+     *
+     * @param scheme concrete discretization, its stencils are inlined into the loops
+     */
+    template <typename Scheme>
+    void computePreliminaryVelocities(const Scheme &scheme);
+
     /**
      * @brief Compute the right hand side of the pressure equation
      */
@@ -70,14 +114,46 @@ private:
     /**
      * @brief Compute the new velocities, u, v, from the preliminary
      *        velocities F, G and the pressure.
+     *
+     * The maximum absolute velocities of the interior are accumulated on the fly.
      */
     void computeVelocities();
 
+    /**
+     * @brief Write the outputs whose schedule is due after the time step
+     *
+     * @param currentTime simulated time at the end of the time step
+     * @param stepNo number of time steps done
+     */
+    void writeOutput(double currentTime, int stepNo);
+
+    /**
+     * @brief start the reduction of the global scalars of the time step, it is completed in computeTimeStepWidth
+     */
+    void beginStepReduction();
+
     Settings settings_;
-    std::shared_ptr<Discretization> discretization_;             //!< discretization instance
-    std::unique_ptr<PressureSolver> pressureSolver_;             //!< pressureSolver instance
-    std::unique_ptr<OutputWriterParaview> outputWriterParaview_; //!< outputWriterParaview instance
-    std::unique_ptr<OutputWriterText> outputWriterText_;         //!< outputWriterText instance
-    std::array<double, 2> meshWidth_;                            //!< mesh width of domain in x and y direction
-    double dt_;                                                  //!< iteration time step
+    std::unique_ptr<ThreadPool> threadPool_;                                //!< threads of the own rank
+    std::shared_ptr<Partitioning> partitioning_;                            //!< subdomain of the own rank
+    std::shared_ptr<Discretization<T, A>> discretization_;                  //!< discretization instance
+    std::unique_ptr<PressureSolver<T, A>> pressureSolver_;                  //!< pressureSolver instance
+    std::unique_ptr<HaloExchange<T>> haloExchange_;                         //!< exchanges the ghost layers of u, v, f and g
+    std::unique_ptr<ReductionBatch> stepReduction_;                         //!< global scalars of the time step, reduced in one message
+    std::unique_ptr<OutputWriter<T>> outputWriterParaview_;                 //!< writer of the vti files, pieces per rank or one shared file
+    std::unique_ptr<OutputWriterTextParallel<T>> outputWriterText_;         //!< outputWriterText instance
+    std::unique_ptr<OutputWriterProbes<T>> outputWriterProbes_;             //!< writer of the values at the probes, only if there are probes
+    OutputSchedule paraviewSchedule_;                                       //!< when the vti files are written
+    OutputSchedule textSchedule_;                                           //!< when the txt files are written
+    OutputSchedule probeSchedule_;                                          //!< when the values at the probes are written
+    std::array<double, 2> meshWidth_;                                       //!< mesh width of domain in x and y direction
+    double dt_;                                                             //!< iteration time step
+    bool communicateInTasks_;                                               //!< if the MPI library allows tasks on other threads than the master to communicate
+    double uMax_;                                                           //!< maximum of |u| in the interior of the own subdomain
+    double vMax_;                                                           //!< maximum of |v| in the interior of the own subdomain
+    int uMaxEntry_;                                                         //!< index of uMax_ in stepReduction_
+    int vMaxEntry_;                                                         //!< index of vMax_ in stepReduction_
+    bool detectSteadyState_;                                                //!< if a schedule writes when the velocities become steady
+    double velocityChange_;                                                 //!< maximum of |du/dt| and |dv/dt| in the own subdomain
+    int velocityChangeEntry_;                                               //!< index of velocityChange_ in stepReduction_
+    bool steadyStateReached_;                                               //!< if the global velocity change of the previous time step is below the tolerance
 };
@@ -10,36 +10,107 @@
  *
  * Implements the first derivatives of u^2, v^2 and u*v according
  * to the central differences scheme
+ *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which the derivatives are evaluated
  */
-class CentralDifferences : public Discretization
+template <typename T = double, typename A = T>
+class CentralDifferences final : public Discretization<T, A>
 {
 public:
+    using Discretization<T, A>::u;
+    using Discretization<T, A>::v;
+    using Discretization<T, A>::dx;
+    using Discretization<T, A>::dy;
+    using typename Discretization<T, A>::ConstView;
+
     /**
      * @brief Constructor
      *
      * @param nCells array containing number of cells in x and y directions
      * @param meshWidth array containing the length of a single cell in x and y directions
+     * @param partitioning subdomain of the grid, the whole domain if not given
      */
-    CentralDifferences(std::array<int, 2> nCells, std::array<double, 2> meshWidth);
+    CentralDifferences(std::array<int, 2> nCells, std::array<double, 2> meshWidth,
+                       std::shared_ptr<Partitioning> partitioning = nullptr);
 
     /**
      * @brief Calculate first derivative of u^2 with respect to x with the
              central differences Scheme
     */
-    double computeDu2Dx(int i, int j) const override;
+    A computeDu2Dx(int i, int j) const override;
     /**
      * @brief Calculate first derivative of v^2 with respect to y with the
               central differences Scheme
     */
-    double computeDv2Dy(int i, int j) const override;
+    A computeDv2Dy(int i, int j) const override;
     /**
      * @brief Calculate first derivative of u*v with respect to x with the
               central differences Scheme
     */
-    double computeDuvDx(int i, int j) const override;
+    A computeDuvDx(int i, int j) const override;
     /**
      * @brief Calculate first derivative of u*v with respect to y with the
               central differences Scheme
     */
-    double computeDuvDy(int i, int j) const override;
+    A computeDuvDy(int i, int j) const override;
+
+    /**
+     * @brief Calculate first derivative of u^2 with respect to x with the
+              central differences Scheme on views of the velocities
+    */
+    A computeDu2Dx(const ConstView &u, int i, int j) const;
+    /**
+     * @brief Calculate first derivative of v^2 with respect to y with the
+              central differences Scheme on views of the velocities
+    */
+    A computeDv2Dy(const ConstView &v, int i, int j) const;
+    /**
+     * @brief Calculate first derivative of u*v with respect to x with the
+              central differences Scheme on views of the velocities
+    */
+    A computeDuvDx(const ConstView &u, const ConstView &v, int i, int j) const;
+    /**
+     * @brief Calculate first derivative of u*v with respect to y with the
+              central differences Scheme on views of the velocities
+    */
+    A computeDuvDy(const ConstView &u, const ConstView &v, int i, int j) const;
 };
+
+template <typename T, typename A>
+inline A CentralDifferences<T, A>::computeDu2Dx(const ConstView &u, int i, int j) const
+{
+    A u_iminus_j = A(0.5) * (u(i, j) + u(i - 1, j));
+    A u_iplus_j = A(0.5) * (u(i + 1, j) + u(i, j));
+    return (u_iplus_j * u_iplus_j - u_iminus_j * u_iminus_j) / A(this->meshWidth_[0]);
+}
+
+template <typename T, typename A>
+inline A CentralDifferences<T, A>::computeDv2Dy(const ConstView &v, int i, int j) const
+{
+    A v_i_jminus = A(0.5) * (v(i, j) + v(i, j - 1));
+    A v_i_jplus = A(0.5) * (v(i, j + 1) + v(i, j));
+    return (v_i_jplus * v_i_jplus - v_i_jminus * v_i_jminus) / A(this->meshWidth_[1]);
+}
+
+template <typename T, typename A>
+inline A CentralDifferences<T, A>::computeDuvDx(const ConstView &u, const ConstView &v, int i, int j) const
+{
+    // left
+    A u_i_jplus = A(0.5) * (u(i, j) + u(i, j + 1));
+    A v_iplus_j = A(0.5) * (v(i + 1, j) + v(i, j));
+    // right
+    A u_iminus1_jplus = A(0.5) * (u(i - 1, j) + u(i - 1, j + 1));
+    A v_iminus_j = A(0.5) * (v(i - 1, j) + v(i, j));
+    return (u_i_jplus * v_iplus_j - u_iminus1_jplus * v_iminus_j) / A(this->meshWidth_[0]);
+}
+
+template <typename T, typename A>
+inline A CentralDifferences<T, A>::computeDuvDy(const ConstView &u, const ConstView &v, int i, int j) const
+{
+    A v_iplus_j = A(0.5) * (v(i + 1, j) + v(i, j));
+    A v_iplus_jminus1 = A(0.5) * (v(i + 1, j - 1) + v(i, j - 1));
+    A u_i_jplus = A(0.5) * (u(i, j) + u(i, j + 1));
+    A u_i_jminus = A(0.5) * (u(i, j) + u(i, j - 1));
+    return (v_iplus_j * u_i_jplus - v_iplus_jminus1 * u_i_jminus) / A(this->meshWidth_[1]);
+}
@@ -1,35 +1,48 @@
 #include "discretization.h"
 
-Discretization::Discretization(std::array<int, 2> nCells, std::array<double, 2> meshWidth) : StaggeredGrid(nCells, meshWidth)
+template <typename T, typename A>
+Discretization<T, A>::Discretization(std::array<int, 2> nCells, std::array<double, 2> meshWidth,
+                                     std::shared_ptr<Partitioning> partitioning) : StaggeredGrid<T>(nCells, meshWidth, partitioning)
 {
 }
 
-double Discretization::computeD2uDx2(int i, int j) const
+template <typename T, typename A>
+A Discretization<T, A>::computeD2uDx2(int i, int j) const
 {
-    return (u(i + 1, j) - 2.0 * u(i, j) + u(i - 1, j)) / (dx() * dx());
+    return computeD2uDx2(this->u_.view(), i, j);
 }
 
-double Discretization::computeD2uDy2(int i, int j) const
+template <typename T, typename A>
+A Discretization<T, A>::computeD2uDy2(int i, int j) const
 {
-    return (u(i, j + 1) - 2.0 * u(i, j) + u(i, j - 1)) / (dy() * dy());
+    return computeD2uDy2(this->u_.view(), i, j);
 }
 
-double Discretization::computeD2vDx2(int i, int j) const
+template <typename T, typename A>
+A Discretization<T, A>::computeD2vDx2(int i, int j) const
 {
-    return (v(i + 1, j) - 2.0 * v(i, j) + v(i - 1, j)) / (dx() * dx());
+    return computeD2vDx2(this->v_.view(), i, j);
 }
 
-double Discretization::computeD2vDy2(int i, int j) const
+template <typename T, typename A>
+A Discretization<T, A>::computeD2vDy2(int i, int j) const
 {
-    return (v(i, j + 1) - 2.0 * v(i, j) + v(i, j - 1)) / (dy() * dy());
+    return computeD2vDy2(this->v_.view(), i, j);
 }
 
-double Discretization::computeDpDx(int i, int j) const
+template <typename T, typename A>
+A Discretization<T, A>::computeDpDx(int i, int j) const
 {
-    return (p(i + 1, j) - p(i, j)) / dx();
+    return computeDpDx(this->p_.view(), i, j);
 }
 
-double Discretization::computeDpDy(int i, int j) const
+template <typename T, typename A>
+A Discretization<T, A>::computeDpDy(int i, int j) const
 {
-    return (p(i, j + 1) - p(i, j)) / dy();
+    return computeDpDy(this->p_.view(), i, j);
 }
+
+// storage and accumulation types: double, float and mixed precision
+template class Discretization<double, double>;
+template class Discretization<float, float>;
+template class Discretization<float, double>;
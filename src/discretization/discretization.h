@@ -11,59 +11,120 @@
  * Interface for the discretization. Computes the
  * needed derivatives to solve the Poisson and
  * continuity equations.
+ *
+ * Every derivative is also available as an inline overload that
+ * evaluates it on a FieldView, these are used in the hot loops.
+ *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which the derivatives are evaluated
  */
-class Discretization : public StaggeredGrid
+template <typename T = double, typename A = T>
+class Discretization : public StaggeredGrid<T>
 {
 public:
+    using StaggeredGrid<T>::u;
+    using StaggeredGrid<T>::v;
+    using StaggeredGrid<T>::p;
+    using StaggeredGrid<T>::dx;
+    using StaggeredGrid<T>::dy;
+
+    using ConstView = FieldView<const T>; //!< read-only view on a field variable
+
     /**
      * @brief Constructor
      *
      * @param nCells array containing number of cells in x and y directions
      * @param meshWidth array containing the length of a single cell in x and y directions
+     * @param partitioning subdomain of the grid, the whole domain if not given
      */
-    Discretization(std::array<int, 2> nCells, std::array<double, 2> meshWidth);
+    Discretization(std::array<int, 2> nCells, std::array<double, 2> meshWidth,
+                   std::shared_ptr<Partitioning> partitioning = nullptr);
 
     /**
      * @brief Calculate first derivative of u^2 with respect to x
      */
-    virtual double computeDu2Dx(int i, int j) const = 0;
+    virtual A computeDu2Dx(int i, int j) const = 0;
     /**
      * @brief Calculate first derivative of v^2 with respect to y
      */
-    virtual double computeDv2Dy(int i, int j) const = 0;
+    virtual A computeDv2Dy(int i, int j) const = 0;
 
     /**
      * @brief Calculate first derivative of u*v with respect to x
      */
-    virtual double computeDuvDx(int i, int j) const = 0;
+    virtual A computeDuvDx(int i, int j) const = 0;
     /**
      * @brief Calculate first derivative of u*v with respect to y
      */
-    virtual double computeDuvDy(int i, int j) const = 0;
+    virtual A computeDuvDy(int i, int j) const = 0;
 
     /**
      * @brief Calculate second derivative of u with respect to x
      */
-    virtual double computeD2uDx2(int i, int j) const;
+    virtual A computeD2uDx2(int i, int j) const;
     /**
      * @brief Calculate second derivative of u with respect to y
      */
-    virtual double computeD2uDy2(int i, int j) const;
+    virtual A computeD2uDy2(int i, int j) const;
     /**
      * @brief Calculate second derivative of v with respect to x
      */
-    virtual double computeD2vDx2(int i, int j) const;
+    virtual A computeD2vDx2(int i, int j) const;
     /**
      * @brief Calculate second derivative of v with respect to y
      */
-    virtual double computeD2vDy2(int i, int j) const;
+    virtual A computeD2vDy2(int i, int j) const;
 
     /**
      * @brief Calculate first derivative of p with respect to x
      */
-    virtual double computeDpDx(int i, int j) const;
+    virtual A computeDpDx(int i, int j) const;
     /**
      * @brief Calculate first derivative of p with respect to y
      */
-    virtual double computeDpDy(int i, int j) const;
+    virtual A computeDpDy(int i, int j) const;
+
+    /**
+     * @brief Calculate second derivative of u with respect to x on a view of u
+     */
+    A computeD2uDx2(const ConstView &u, int i, int j) const
+    {
+        return (u(i + 1, j) - A(2.0) * u(i, j) + u(i - 1, j)) / A(this->meshWidth_[0] * this->meshWidth_[0]);
+    }
+    /**
+     * @brief Calculate second derivative of u with respect to y on a view of u
+     */
+    A computeD2uDy2(const ConstView &u, int i, int j) const
+    {
+        return (u(i, j + 1) - A(2.0) * u(i, j) + u(i, j - 1)) / A(this->meshWidth_[1] * this->meshWidth_[1]);
+    }
+    /**
+     * @brief Calculate second derivative of v with respect to x on a view of v
+     */
+    A computeD2vDx2(const ConstView &v, int i, int j) const
+    {
+        return (v(i + 1, j) - A(2.0) * v(i, j) + v(i - 1, j)) / A(this->meshWidth_[0] * this->meshWidth_[0]);
+    }
+    /**
+     * @brief Calculate second derivative of v with respect to y on a view of v
+     */
+    A computeD2vDy2(const ConstView &v, int i, int j) const
+    {
+        return (v(i, j + 1) - A(2.0) * v(i, j) + v(i, j - 1)) / A(this->meshWidth_[1] * this->meshWidth_[1]);
+    }
+
+    /**
+     * @brief Calculate first derivative of p with respect to x on a view of p
+     */
+    A computeDpDx(const ConstView &p, int i, int j) const
+    {
+        return (A(p(i + 1, j)) - p(i, j)) / A(this->meshWidth_[0]);
+    }
+    /**
+     * @brief Calculate first derivative of p with respect to y on a view of p
+     */
+    A computeDpDy(const ConstView &p, int i, int j) const
+    {
+        return (A(p(i, j + 1)) - p(i, j)) / A(this->meshWidth_[1]);
+    }
 };
\ No newline at end of file
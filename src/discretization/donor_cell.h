@@ -11,40 +11,131 @@
  *
  * Implements the first derivatives of u^2, v^2 and u*v according
  * to the donor cell scheme
+ *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which the derivatives are evaluated
  */
-class DonorCell : public Discretization
+template <typename T = double, typename A = T>
+class DonorCell final : public Discretization<T, A>
 {
 public:
+    using Discretization<T, A>::u;
+    using Discretization<T, A>::v;
+    using Discretization<T, A>::dx;
+    using Discretization<T, A>::dy;
+    using typename Discretization<T, A>::ConstView;
+
     /**
      * @brief Constructor
      *
      * @param nCells array containing number of cells in x and y directions
      * @param meshWidth array containing the length of a single cell in x and y directions
      * @param alpha weight factor between central differences and donor cell schemes
+     * @param partitioning subdomain of the grid, the whole domain if not given
      */
-    DonorCell(std::array<int, 2> nCells, std::array<double, 2> meshWidth, double alpha);
+    DonorCell(std::array<int, 2> nCells, std::array<double, 2> meshWidth, double alpha,
+              std::shared_ptr<Partitioning> partitioning = nullptr);
 
     /**
      * @brief Calculate first derivative of u^2 with respect to x with the
               donor cell Scheme
     */
-    double computeDu2Dx(int i, int j) const override;
+    A computeDu2Dx(int i, int j) const override;
     /**
      * @brief Calculate first derivative of v^2 with respect to y with the
               donor cell Scheme
     */
-    double computeDv2Dy(int i, int j) const override;
+    A computeDv2Dy(int i, int j) const override;
     /**
      * @brief Calculate first derivative of u*v with respect to x with the
               donor cell Scheme
     */
-    double computeDuvDx(int i, int j) const override;
+    A computeDuvDx(int i, int j) const override;
     /**
      * @brief Calculate first derivative of u*v with respect to y with the
               donor cell Scheme
     */
-    double computeDuvDy(int i, int j) const override;
+    A computeDuvDy(int i, int j) const override;
+
+    /**
+     * @brief Calculate first derivative of u^2 with respect to x with the
+              donor cell Scheme on views of the velocities
+    */
+    A computeDu2Dx(const ConstView &u, int i, int j) const;
+    /**
+     * @brief Calculate first derivative of v^2 with respect to y with the
+              donor cell Scheme on views of the velocities
+    */
+    A computeDv2Dy(const ConstView &v, int i, int j) const;
+    /**
+     * @brief Calculate first derivative of u*v with respect to x with the
+              donor cell Scheme on views of the velocities
+    */
+    A computeDuvDx(const ConstView &u, const ConstView &v, int i, int j) const;
+    /**
+     * @brief Calculate first derivative of u*v with respect to y with the
+              donor cell Scheme on views of the velocities
+    */
+    A computeDuvDy(const ConstView &u, const ConstView &v, int i, int j) const;
 
 private:
-    const double alpha_; //!< weight factor between central differences and donor cell schemes
-};
\ No newline at end of file
+    const A alpha_; //!< weight factor between central differences and donor cell schemes
+};
+
+template <typename T, typename A>
+inline A DonorCell<T, A>::computeDu2Dx(const ConstView &u, int i, int j) const
+{
+    // Calculation via abs
+    A u_iplus_j = A(0.5) * (u(i, j) + u(i + 1, j));
+    A u_ipdiff_j = A(0.5) * (u(i, j) - u(i + 1, j));
+    A u_iminus_j = A(0.5) * (u(i - 1, j) + u(i, j));
+    A u_imdiff_j = A(0.5) * (u(i - 1, j) - u(i, j));
+
+    A term_1 = (u_iplus_j * u_iplus_j - u_iminus_j * u_iminus_j);
+    A term_2 = (std::abs(u_iplus_j) * u_ipdiff_j - std::abs(u_iminus_j) * u_imdiff_j);
+    return (term_1 + alpha_ * term_2) / A(this->meshWidth_[0]);
+}
+
+template <typename T, typename A>
+inline A DonorCell<T, A>::computeDv2Dy(const ConstView &v, int i, int j) const
+{
+    // Absolute Value
+    A v_i_jplus = A(0.5) * (v(i, j) + v(i, j + 1));
+    A v_i_jpdiff = A(0.5) * (v(i, j) - v(i, j + 1));
+    A v_i_jminus = A(0.5) * (v(i, j - 1) + v(i, j));
+    A v_i_jmdiff = A(0.5) * (v(i, j - 1) - v(i, j));
+
+    A term_1 = (v_i_jplus * v_i_jplus - v_i_jminus * v_i_jminus);
+    A term_2 = (std::abs(v_i_jplus) * v_i_jpdiff - std::abs(v_i_jminus) * v_i_jmdiff);
+    return (term_1 + alpha_ * term_2) / A(this->meshWidth_[1]);
+}
+
+template <typename T, typename A>
+inline A DonorCell<T, A>::computeDuvDx(const ConstView &u, const ConstView &v, int i, int j) const
+{
+    A u_i_jplus = A(0.5) * (u(i, j + 1) + u(i, j));
+    A u_iminus1_jplus = A(0.5) * (u(i - 1, j + 1) + u(i - 1, j));
+    A v_iplus_j = A(0.5) * (v(i, j) + v(i + 1, j));
+    A v_ipdiff_j = A(0.5) * (v(i, j) - v(i + 1, j));
+    A v_iminus_j = A(0.5) * (v(i - 1, j) + v(i, j));
+    A v_imdiff_j = A(0.5) * (v(i - 1, j) - v(i, j));
+
+    A term_1 = u_i_jplus * v_iplus_j - u_iminus1_jplus * v_iminus_j;
+    A term_2 = std::abs(u_i_jplus) * v_ipdiff_j - std::abs(u_iminus1_jplus) * v_imdiff_j;
+    return (term_1 + alpha_ * term_2) / A(this->meshWidth_[0]);
+}
+
+template <typename T, typename A>
+inline A DonorCell<T, A>::computeDuvDy(const ConstView &u, const ConstView &v, int i, int j) const
+{
+    A v_iplus_j = A(0.5) * (v(i + 1, j) + v(i, j));
+    A v_iplus_jminus1 = A(0.5) * (v(i + 1, j - 1) + v(i, j - 1));
+    A u_i_jplus = A(0.5) * (u(i, j) + u(i, j + 1));
+    A u_i_jpdiff = A(0.5) * (u(i, j) - u(i, j + 1));
+    A u_i_jminus = A(0.5) * (u(i, j - 1) + u(i, j));
+    A u_i_jmdiff = A(0.5) * (u(i, j - 1) - u(i, j));
+
+    A term_1 = v_iplus_j * u_i_jplus - v_iplus_jminus1 * u_i_jminus;
+    A term_2 = std::abs(v_iplus_j) * u_i_jpdiff - std::abs(v_iplus_jminus1) * u_i_jmdiff;
+    return (term_1 + alpha_ * term_2) / A(this->meshWidth_[1]);
+}
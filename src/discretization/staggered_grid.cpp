@@ -1,217 +1,332 @@
 #include "staggered_grid.h"
 
-StaggeredGrid::StaggeredGrid(std::array<int, 2> nCells, std::array<double, 2> meshWidth) : nCells_(nCells),
-                                                                                           meshWidth_(meshWidth),
-                                                                                           u_({nCells[0] + 2, nCells[1] + 2}, {0., -0.5 * meshWidth[1]}, meshWidth),
-                                                                                           v_({nCells[0] + 2, nCells[1] + 2}, {-0.5 * meshWidth[0], 0.}, meshWidth),
-                                                                                           p_({nCells[0] + 2, nCells[1] + 2}, {-0.5 * meshWidth[0], -0.5 * meshWidth[1]}, meshWidth),
-                                                                                           f_({nCells[0] + 2, nCells[1] + 2}, {0., -0.5 * meshWidth[1]}, meshWidth),
-                                                                                           g_({nCells[0] + 2, nCells[1] + 2}, {-0.5 * meshWidth[0], 0}, meshWidth),
-                                                                                           rhs_({nCells[0] + 2, nCells[1] + 2}, {-0.5 * meshWidth[0], -0.5 * meshWidth[1]}, meshWidth)
+template <typename T>
+StaggeredGrid<T>::StaggeredGrid(std::array<int, 2> nCells, std::array<double, 2> meshWidth,
+                                std::shared_ptr<Partitioning> partitioning, bool withIntermediates) : nCells_(nCells),
+                                                                                              meshWidth_(meshWidth),
+                                                                                              u_({nCells[0] + 2, nCells[1] + 2}, {0., -0.5 * meshWidth[1]}, meshWidth),
+                                                                                              v_({nCells[0] + 2, nCells[1] + 2}, {-0.5 * meshWidth[0], 0.}, meshWidth),
+                                                                                              p_({nCells[0] + 2, nCells[1] + 2}, {-0.5 * meshWidth[0], -0.5 * meshWidth[1]}, meshWidth),
+                                                                                              f_(intermediateSize(nCells, withIntermediates), {0., -0.5 * meshWidth[1]}, meshWidth),
+                                                                                              g_(intermediateSize(nCells, withIntermediates), {-0.5 * meshWidth[0], 0}, meshWidth),
+                                                                                              rhs_(intermediateSize(nCells, withIntermediates), {-0.5 * meshWidth[0], -0.5 * meshWidth[1]}, meshWidth),
+                                                                                              partitioning_(partitioning ? partitioning : std::make_shared<Partitioning>(nCells))
 {
 }
 
-const std::array<double, 2> StaggeredGrid::meshWidth() const
+template <typename T>
+std::array<int, 2> StaggeredGrid<T>::intermediateSize(std::array<int, 2> nCells, bool withIntermediates)
+{
+    // a field variable has at least one value, a grid without intermediates keeps one placeholder value each
+    if (!withIntermediates)
+        return {1, 1};
+    return {nCells[0] + 2, nCells[1] + 2};
+}
+
+template <typename T>
+std::shared_ptr<Partitioning> StaggeredGrid<T>::partitioning() const
+{
+    return partitioning_;
+}
+
+template <typename T>
+const std::array<double, 2> StaggeredGrid<T>::meshWidth() const
 {
     return meshWidth_;
 }
 
-const std::array<int, 2> StaggeredGrid::nCells() const
+template <typename T>
+const std::array<int, 2> StaggeredGrid<T>::nCells() const
 {
     return nCells_;
 }
 
-const FieldVariable &StaggeredGrid::u() const
+template <typename T>
+const FieldVariable<T> &StaggeredGrid<T>::u() const
+{
+    return u_;
+}
+
+template <typename T>
+const FieldVariable<T> &StaggeredGrid<T>::v() const
+{
+    return v_;
+}
+
+template <typename T>
+const FieldVariable<T> &StaggeredGrid<T>::p() const
+{
+    return p_;
+}
+
+template <typename T>
+const FieldVariable<T> &StaggeredGrid<T>::f() const
+{
+    return f_;
+}
+
+template <typename T>
+const FieldVariable<T> &StaggeredGrid<T>::g() const
+{
+    return g_;
+}
+
+template <typename T>
+const FieldVariable<T> &StaggeredGrid<T>::rhs() const
+{
+    return rhs_;
+}
+
+template <typename T>
+FieldVariable<T> &StaggeredGrid<T>::u()
 {
     return u_;
 }
 
-const FieldVariable &StaggeredGrid::v() const
+template <typename T>
+FieldVariable<T> &StaggeredGrid<T>::v()
 {
     return v_;
 }
 
-const FieldVariable &StaggeredGrid::p() const
+template <typename T>
+FieldVariable<T> &StaggeredGrid<T>::p()
 {
     return p_;
 }
 
-const FieldVariable &StaggeredGrid::rhs() const
+template <typename T>
+FieldVariable<T> &StaggeredGrid<T>::f()
+{
+    return f_;
+}
+
+template <typename T>
+FieldVariable<T> &StaggeredGrid<T>::g()
+{
+    return g_;
+}
+
+template <typename T>
+FieldVariable<T> &StaggeredGrid<T>::rhs()
 {
     return rhs_;
 }
 
-double StaggeredGrid::u(int i, int j) const
+template <typename T>
+T StaggeredGrid<T>::u(int i, int j) const
 {
     return u_(i, j);
 }
 
-double &StaggeredGrid::u(int i, int j)
+template <typename T>
+T &StaggeredGrid<T>::u(int i, int j)
 {
     return u_(i, j);
 }
 
-double StaggeredGrid::v(int i, int j) const
+template <typename T>
+T StaggeredGrid<T>::v(int i, int j) const
 {
     return v_(i, j);
 }
 
-double &StaggeredGrid::v(int i, int j)
+template <typename T>
+T &StaggeredGrid<T>::v(int i, int j)
 {
     return v_(i, j);
 }
 
-double StaggeredGrid::p(int i, int j) const
+template <typename T>
+T StaggeredGrid<T>::p(int i, int j) const
 {
     return p_(i, j);
 }
 
-double &StaggeredGrid::p(int i, int j)
+template <typename T>
+T &StaggeredGrid<T>::p(int i, int j)
 {
     return p_(i, j);
 }
 
-double &StaggeredGrid::f(int i, int j)
+template <typename T>
+T &StaggeredGrid<T>::f(int i, int j)
 {
     return f_(i, j);
 }
 
-double &StaggeredGrid::g(int i, int j)
+template <typename T>
+T &StaggeredGrid<T>::g(int i, int j)
 {
     return g_(i, j);
 }
 
-double &StaggeredGrid::rhs(int i, int j)
+template <typename T>
+T &StaggeredGrid<T>::rhs(int i, int j)
 {
     return rhs_(i, j);
 }
 
-double StaggeredGrid::dx() const
+template <typename T>
+double StaggeredGrid<T>::dx() const
 {
     return meshWidth_[0];
 }
 
-double StaggeredGrid::dy() const
+template <typename T>
+double StaggeredGrid<T>::dy() const
 {
     return meshWidth_[1];
 }
 
-int StaggeredGrid::uIBegin() const
+template <typename T>
+int StaggeredGrid<T>::uIBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::uIEnd() const
+template <typename T>
+int StaggeredGrid<T>::uIEnd() const
 {
-    return nCells_[0] + 1;
+    // include the face shared with the right neighbour
+    return partitioning_->ownPartitionContainsRightBoundary() ? nCells_[0] + 1 : nCells_[0] + 2;
 }
 
-int StaggeredGrid::uJBegin() const
+template <typename T>
+int StaggeredGrid<T>::uJBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::uJEnd() const
+template <typename T>
+int StaggeredGrid<T>::uJEnd() const
 {
     return nCells_[1] + 2;
 }
 
-int StaggeredGrid::fIBegin() const
+template <typename T>
+int StaggeredGrid<T>::fIBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::fIEnd() const
+template <typename T>
+int StaggeredGrid<T>::fIEnd() const
 {
-    return nCells_[0] + 1;
+    // include the face shared with the right neighbour
+    return partitioning_->ownPartitionContainsRightBoundary() ? nCells_[0] + 1 : nCells_[0] + 2;
 }
 
-int StaggeredGrid::fJBegin() const
+template <typename T>
+int StaggeredGrid<T>::fJBegin() const
 {
     return 1;
 }
 
-int StaggeredGrid::fJEnd() const
+template <typename T>
+int StaggeredGrid<T>::fJEnd() const
 {
     return nCells_[1] + 1;
 }
 
-int StaggeredGrid::vIBegin() const
+template <typename T>
+int StaggeredGrid<T>::vIBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::vIEnd() const
+template <typename T>
+int StaggeredGrid<T>::vIEnd() const
 {
     return nCells_[0] + 2;
 }
 
-int StaggeredGrid::vJBegin() const
+template <typename T>
+int StaggeredGrid<T>::vJBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::vJEnd() const
+template <typename T>
+int StaggeredGrid<T>::vJEnd() const
 {
-    return nCells_[1] + 1;
+    // include the face shared with the top neighbour
+    return partitioning_->ownPartitionContainsTopBoundary() ? nCells_[1] + 1 : nCells_[1] + 2;
 }
 
-int StaggeredGrid::gIBegin() const
+template <typename T>
+int StaggeredGrid<T>::gIBegin() const
 {
     return 1;
 }
 
-int StaggeredGrid::gIEnd() const
+template <typename T>
+int StaggeredGrid<T>::gIEnd() const
 {
     return nCells_[0] + 1;
 }
 
-int StaggeredGrid::gJBegin() const
+template <typename T>
+int StaggeredGrid<T>::gJBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::gJEnd() const
+template <typename T>
+int StaggeredGrid<T>::gJEnd() const
 {
-    return nCells_[1] + 1;
+    // include the face shared with the top neighbour
+    return partitioning_->ownPartitionContainsTopBoundary() ? nCells_[1] + 1 : nCells_[1] + 2;
 }
 
-int StaggeredGrid::pIBegin() const
+template <typename T>
+int StaggeredGrid<T>::pIBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::pIEnd() const
+template <typename T>
+int StaggeredGrid<T>::pIEnd() const
 {
     return nCells_[0] + 2;
 }
 
-int StaggeredGrid::pJBegin() const
+template <typename T>
+int StaggeredGrid<T>::pJBegin() const
 {
     return 0;
 }
 
-int StaggeredGrid::pJEnd() const
+template <typename T>
+int StaggeredGrid<T>::pJEnd() const
 {
     return nCells_[1] + 2;
 }
 
-int StaggeredGrid::rhsIBegin() const
+template <typename T>
+int StaggeredGrid<T>::rhsIBegin() const
 {
     return 1;
 }
 
-int StaggeredGrid::rhsIEnd() const
+template <typename T>
+int StaggeredGrid<T>::rhsIEnd() const
 {
     return nCells_[0] + 1;
 }
 
-int StaggeredGrid::rhsJBegin() const
+template <typename T>
+int StaggeredGrid<T>::rhsJBegin() const
 {
     return 1;
 }
 
-int StaggeredGrid::rhsJEnd() const
+template <typename T>
+int StaggeredGrid<T>::rhsJEnd() const
 {
     return nCells_[1] + 1;
-}
\ No newline at end of file
+}
+
+// scalar types used for the field storage
+template class StaggeredGrid<float>;
+template class StaggeredGrid<double>;
@@ -1,7 +1,11 @@
+#pragma once
+
 #include <array>
 #include <vector>
 #include <iostream>
 #include "../storage/field_variable.h"
+#include "../parallel/partitioning.h"
+#include <memory>
 
 /**
  * @class StaggeredGrid
@@ -10,7 +14,14 @@
  * Create the necessary u, v, p, f, g, rhs field variables and
  * define the first valid index for each of the field variables,
  * as well as the (one after) last valid index
+ *
+ * In a distributed run the grid holds one subdomain. The velocities on the faces between
+ * two subdomains are computed by the rank left of resp. below the face, therefore the
+ * loop ranges of u, f resp. v, g include the last face if it is not on the boundary of the domain.
+ *
+ * @tparam T scalar type used to store the field variables
  */
+template <typename T = double>
 class StaggeredGrid
 {
 public:
@@ -19,13 +30,20 @@ public:
      *
      * @param nCells array containing number of cells in x and y directions
      * @param meshWidth array containing the length of a single cell in x and y directions
+     * @param partitioning subdomain of the grid, the whole domain if not given
+     * @param withIntermediates if false, f, g and rhs are not allocated and must not be used, e.g. for snapshots of u, v and p
      */
-    StaggeredGrid(std::array<int, 2> nCells, std::array<double, 2> meshWidth);
+    StaggeredGrid(std::array<int, 2> nCells, std::array<double, 2> meshWidth,
+                  std::shared_ptr<Partitioning> partitioning = nullptr, bool withIntermediates = true);
 
     /**
      * @brief  Get the length of a single cell in x and y directions
      */
     const std::array<double, 2> meshWidth() const;
+    /**
+     * @brief  Get the partitioning the grid is part of
+     */
+    std::shared_ptr<Partitioning> partitioning() const;
     /**
      * @brief  Get number of cells in x and y directions
      */
@@ -34,59 +52,92 @@ public:
     /**
      * @brief  Get a reference to the field variable u
      */
-    const FieldVariable &u() const;
+    const FieldVariable<T> &u() const;
     /**
      * @brief  Get a reference to the field variable v
      */
-    const FieldVariable &v() const;
+    const FieldVariable<T> &v() const;
     /**
      * @brief  Get a reference to the field variable p
      */
-    const FieldVariable &p() const;
+    const FieldVariable<T> &p() const;
+    /**
+     * @brief  Get a reference to the field variable f
+     */
+    const FieldVariable<T> &f() const;
+    /**
+     * @brief  Get a reference to the field variable g
+     */
+    const FieldVariable<T> &g() const;
     /**
      * @brief  Get a reference to the field variable rhs
      */
-    const FieldVariable &rhs() const;
+    const FieldVariable<T> &rhs() const;
+
+    /**
+     * @brief  Get a modifiable reference to the field variable u
+     */
+    FieldVariable<T> &u();
+    /**
+     * @brief  Get a modifiable reference to the field variable v
+     */
+    FieldVariable<T> &v();
+    /**
+     * @brief  Get a modifiable reference to the field variable p
+     */
+    FieldVariable<T> &p();
+    /**
+     * @brief  Get a modifiable reference to the field variable f
+     */
+    FieldVariable<T> &f();
+    /**
+     * @brief  Get a modifiable reference to the field variable g
+     */
+    FieldVariable<T> &g();
+    /**
+     * @brief  Get a modifiable reference to the field variable rhs
+     */
+    FieldVariable<T> &rhs();
 
     /**
      * @brief  Access value of u in element (i,j), declared constant
      */
-    double u(int i, int j) const;
+    T u(int i, int j) const;
     /**
      * @brief  Access value of u in element (i,j)
      */
-    double &u(int i, int j);
+    T &u(int i, int j);
 
     /**
      * @brief  Access value of v in element (i,j), declared constant
      */
-    double v(int i, int j) const;
+    T v(int i, int j) const;
     /**
      * @brief  Access value of v in element (i,j)
      */
-    double &v(int i, int j);
+    T &v(int i, int j);
 
     /**
      * @brief  Access value of p in element (i,j), declared constant
      */
-    double p(int i, int j) const;
+    T p(int i, int j) const;
     /**
      * @brief  Access value of p in element (i,j)
      */
-    double &p(int i, int j);
+    T &p(int i, int j);
 
     /**
      * @brief  Access value of f in element (i,j)
      */
-    double &f(int i, int j);
+    T &f(int i, int j);
     /**
      * @brief  Access value of g in element (i,j)
      */
-    double &g(int i, int j);
+    T &g(int i, int j);
     /**
      * @brief  Access value of rhs in element (i,j)
      */
-    double &rhs(int i, int j);
+    T &rhs(int i, int j);
 
     /**
      * @brief  Get the mesh width in x-direction
@@ -206,12 +257,18 @@ public:
     int rhsJEnd() const;
 
 protected:
-    const std::array<int, 2> nCells_;       //!< array containing number of cells in x and y directions
-    const std::array<double, 2> meshWidth_; //!< array containing the sizes of cell edges in x and y directions
-    FieldVariable u_;                       //!< instance of the field variable u
-    FieldVariable v_;                       //!< instance of the field variable v
-    FieldVariable p_;                       //!< instance of the field variable p
-    FieldVariable f_;                       //!< instance of the field variable f
-    FieldVariable g_;                       //!< instance of the field variable g
-    FieldVariable rhs_;                     //!< instance of the field variable rhs
+    /**
+     * @brief  size of f, g and rhs, a single placeholder value if they are not needed
+     */
+    static std::array<int, 2> intermediateSize(std::array<int, 2> nCells, bool withIntermediates);
+
+    const std::array<int, 2> nCells_;            //!< array containing number of cells in x and y directions
+    const std::array<double, 2> meshWidth_;      //!< array containing the sizes of cell edges in x and y directions
+    FieldVariable<T> u_;                         //!< instance of the field variable u
+    FieldVariable<T> v_;                         //!< instance of the field variable v
+    FieldVariable<T> p_;                         //!< instance of the field variable p
+    FieldVariable<T> f_;                         //!< instance of the field variable f
+    FieldVariable<T> g_;                         //!< instance of the field variable g
+    FieldVariable<T> rhs_;                       //!< instance of the field variable rhs
+    std::shared_ptr<Partitioning> partitioning_; //!< subdomain of the grid
 };
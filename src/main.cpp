@@ -1,38 +1,54 @@
+#include "computation.h"
+
 #include <mpi.h>
-#include <stdio.h>
 #include <iostream>
 
-int main(int argc, char** argv) {
-    // Initialize the MPI environment
-  MPI_Init(NULL, NULL);
-  // Find out rank, size
-  int world_rank;
-  MPI_Comm_rank(MPI_COMM_WORLD, &world_rank);
-  int world_size;
-  MPI_Comm_size(MPI_COMM_WORLD, &world_size);
+/**
+ * @brief Run a simulation with the given storage and accumulation types
+ *
+ * @param argc counts of CLI commands
+ * @param argv values of CLI commands, expect settings.txt filename
+ */
+template <typename T, typename A>
+void runComputation(int argc, char *argv[])
+{
+  Computation<T, A> computation;
+  computation.initialize(argc, argv);
+  computation.runSimulation();
+}
 
-  int token;
-  // Receive from the lower process and send to the higher process. Take care
-  // of the special case when you are the first process to prevent deadlock.
-  if (world_rank != 0) {
-    MPI_Recv(&token, 1, MPI_INT, world_rank - 1, 0, MPI_COMM_WORLD,
-             MPI_STATUS_IGNORE);
-    printf("Process %d received token %d from process %d\n", world_rank, token,
-           world_rank - 1);
-  } else {
-    // Set the token's value if you are process 0
-    token = -1;
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    std::cout << "usage: " << argv[0] << " <filename>" << std::endl;
+    return EXIT_FAILURE;
   }
-  MPI_Send(&token, 1, MPI_INT, (world_rank + 1) % world_size, 0,
-           MPI_COMM_WORLD);
-  // Now process 0 can receive from the last process. This makes sure that at
-  // least one MPI_Send is initialized before all MPI_Recvs (again, to prevent
-  // deadlock)
-  if (world_rank == 0) {
-    MPI_Recv(&token, 1, MPI_INT, world_size - 1, 0, MPI_COMM_WORLD,
-             MPI_STATUS_IGNORE);
-    printf("Process %d received token %d from process %d\n", world_rank, token,
-           world_size - 1);
+
+  // Initialize the MPI environment, the simulation calls MPI from one thread at a time, the master or
+  // the task that begins a halo exchange, the I/O thread of the output may communicate at the same time
+  int threadSupport = MPI_THREAD_SINGLE;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &threadSupport);
+  if (threadSupport < MPI_THREAD_FUNNELED)
+    std::cerr << "Warning: the MPI library does not support threads, only the master thread calls MPI." << std::endl;
+
+  // the precision has to be known before the field variables are created
+  Settings settings;
+  settings.loadFromFile(argv[1]);
+
+  if (settings.precision == "float")
+  {
+    runComputation<float, float>(argc, argv);
   }
+  else if (settings.precision == "mixed")
+  {
+    runComputation<float, double>(argc, argv);
+  }
+  else
+  {
+    runComputation<double, double>(argc, argv);
+  }
+
   MPI_Finalize();
-}
\ No newline at end of file
+  return EXIT_SUCCESS;
+}
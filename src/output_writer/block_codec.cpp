@@ -0,0 +1,346 @@
+#include "block_codec.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+  //! read 4 bytes as one integer, for the hash of a possible match
+  std::uint32_t read32(const char *source)
+  {
+    std::uint32_t value;
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+  }
+
+  //! append the length of literals or of a match that does not fit into its 4 bits of the token
+  void writeLength(std::vector<char> &out, std::size_t length)
+  {
+    for (; length >= 255; length -= 255)
+      out.push_back(char(255));
+    out.push_back(char(length));
+  }
+
+  //! read a length written by writeLength and add it
+  std::size_t readLength(const unsigned char *source, std::size_t size, std::size_t &position)
+  {
+    std::size_t length = 0;
+    unsigned char byte = 255;
+    while (byte == 255 && position < size)
+    {
+      byte = source[position++];
+      length += byte;
+    }
+    return length;
+  }
+
+  /**
+   * @brief prediction of the multiple at index from its neighbours in the block that starts at begin:
+   *        the previous node plus the node below minus the node below the previous node
+   */
+  std::int64_t predict(const std::vector<std::int64_t> &multiples, std::size_t index, std::size_t begin,
+                       std::size_t nComponents, std::size_t rowLength)
+  {
+    const std::size_t k = index - begin;
+    if (k >= rowLength + nComponents)
+      return multiples[k - nComponents] + multiples[k - rowLength] - multiples[k - rowLength - nComponents];
+    if (k >= nComponents)
+      return multiples[k - nComponents];
+    return 0;
+  }
+}
+
+BlockCodec::BlockCodec(Method method, double tolerance) : method_(method), tolerance_(tolerance)
+{
+  if (method_ == Method::lossy && !(tolerance_ > 0))
+    throw std::invalid_argument("The lossy output compression needs a positive tolerance.");
+}
+
+BlockCodec::Method BlockCodec::methodFromName(std::string name)
+{
+  if (name == "none")
+    return Method::none;
+  if (name == "lz4")
+    return Method::lz4;
+  if (name == "shuffle")
+    return Method::shuffle;
+  if (name == "lossy")
+    return Method::lossy;
+  throw std::invalid_argument("Supported output compressions are none, lz4, shuffle and lossy.");
+}
+
+BlockCodec::Method BlockCodec::method() const
+{
+  return method_;
+}
+
+double BlockCodec::tolerance() const
+{
+  return tolerance_;
+}
+
+std::string BlockCodec::compressorName() const
+{
+  switch (method_)
+  {
+  case Method::lz4:
+    return "vtkLZ4DataCompressor";
+  case Method::shuffle:
+    return "numsimShuffleLZ4";
+  case Method::lossy:
+    return "numsimLossyLZ4";
+  default:
+    return "";
+  }
+}
+
+std::vector<char> BlockCodec::encode(const char *values, std::size_t nValues, int valueSize, int nComponents, int rowLength) const
+{
+  assert(method_ != Method::none);
+  assert(method_ != Method::lossy || valueSize == sizeof(double));
+
+  const std::size_t valuesPerBlock = blockSize / valueSize;
+  const std::size_t nBlocks = (nValues + valuesPerBlock - 1) / valuesPerBlock;
+  std::vector<std::vector<char>> blocks(nBlocks);
+
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t blockNo = 0; blockNo < nBlocks; blockNo++)
+  {
+    const std::size_t begin = blockNo * valuesPerBlock;
+    blocks[blockNo] = encodeBlock(values, begin, std::min(begin + valuesPerBlock, nValues), valueSize, nComponents, rowLength);
+  }
+
+  // header of the compressed vtk arrays with UInt64 sizes
+  std::vector<std::uint64_t> header = {nBlocks, blockSize, (valueSize * nValues) % blockSize};
+  for (const std::vector<char> &block : blocks)
+    header.push_back(block.size());
+
+  std::vector<char> encoded(header.size() * sizeof(std::uint64_t));
+  std::memcpy(encoded.data(), header.data(), encoded.size());
+  for (const std::vector<char> &block : blocks)
+    encoded.insert(encoded.end(), block.begin(), block.end());
+  return encoded;
+}
+
+std::vector<char> BlockCodec::encodeBlock(const char *values, std::size_t begin, std::size_t end, int valueSize,
+                                          int nComponents, int rowLength) const
+{
+  const std::size_t nValues = end - begin;
+  const char *bytes = values + begin * valueSize;
+
+  if (method_ == Method::lz4)
+    return compressLz4(bytes, valueSize * nValues);
+
+  if (method_ == Method::shuffle)
+  {
+    std::vector<char> shuffled;
+    shuffled.reserve(valueSize * nValues);
+    for (int component = 0; component < nComponents; component++)
+    {
+      for (int byteNo = 0; byteNo < valueSize; byteNo++)
+      {
+        for (std::size_t index = component; index < nValues; index += nComponents)
+          shuffled.push_back(bytes[index * valueSize + byteNo]);
+      }
+    }
+    return compressLz4(shuffled.data(), shuffled.size());
+  }
+
+  // lossy: residuals of the predicted multiples of 2 * tolerance as zigzag encoded variable length integers
+  std::vector<std::int64_t> multiples(nValues);
+  std::vector<char> residuals;
+  residuals.reserve(2 * nValues);
+  for (std::size_t index = begin; index < end; index++)
+  {
+    double value;
+    std::memcpy(&value, values + index * sizeof(double), sizeof(double));
+    const std::int64_t multiple = std::llround(value / (2 * tolerance_));
+    multiples[index - begin] = multiple;
+    const std::int64_t residual = multiple - predict(multiples, index, begin, nComponents, rowLength);
+    std::uint64_t zigzag = (std::uint64_t(residual) << 1) ^ std::uint64_t(residual >> 63);
+    for (; zigzag >= 0x80; zigzag >>= 7)
+      residuals.push_back(char(zigzag | 0x80));
+    residuals.push_back(char(zigzag));
+  }
+  return compressLz4(residuals.data(), residuals.size());
+}
+
+std::vector<char> BlockCodec::decode(const char *data, std::size_t size, int valueSize, int nComponents, int rowLength) const
+{
+  assert(method_ != Method::none);
+
+  std::uint64_t counts[3];
+  if (size < sizeof(counts))
+    throw std::invalid_argument("Encoded array is too short.");
+  std::memcpy(counts, data, sizeof(counts));
+  const std::uint64_t nBlocks = counts[0];
+  const std::uint64_t lastBlockSize = counts[2] == 0 ? counts[1] : counts[2];
+  const std::uint64_t nValues = nBlocks == 0 ? 0 : ((nBlocks - 1) * counts[1] + lastBlockSize) / valueSize;
+
+  std::vector<std::uint64_t> blockSizes(nBlocks);
+  std::memcpy(blockSizes.data(), data + sizeof(counts), nBlocks * sizeof(std::uint64_t));
+
+  std::vector<char> values(nValues * valueSize);
+  std::size_t position = sizeof(counts) + nBlocks * sizeof(std::uint64_t);
+  const std::size_t valuesPerBlock = counts[1] / valueSize;
+  for (std::size_t blockNo = 0; blockNo < nBlocks; blockNo++)
+  {
+    const std::size_t begin = blockNo * valuesPerBlock;
+    decodeBlock(data + position, blockSizes[blockNo], values.data(), begin, std::min<std::size_t>(begin + valuesPerBlock, nValues),
+                valueSize, nComponents, rowLength);
+    position += blockSizes[blockNo];
+  }
+  return values;
+}
+
+void BlockCodec::decodeBlock(const char *data, std::size_t size, char *values, std::size_t begin, std::size_t end,
+                             int valueSize, int nComponents, int rowLength) const
+{
+  const std::size_t nValues = end - begin;
+  char *bytes = values + begin * valueSize;
+
+  if (method_ == Method::lz4)
+  {
+    const std::vector<char> decompressed = decompressLz4(data, size, valueSize * nValues);
+    std::memcpy(bytes, decompressed.data(), decompressed.size());
+    return;
+  }
+
+  if (method_ == Method::shuffle)
+  {
+    const std::vector<char> shuffled = decompressLz4(data, size, valueSize * nValues);
+    std::size_t position = 0;
+    for (int component = 0; component < nComponents; component++)
+    {
+      for (int byteNo = 0; byteNo < valueSize; byteNo++)
+      {
+        for (std::size_t index = component; index < nValues; index += nComponents)
+          bytes[index * valueSize + byteNo] = shuffled[position++];
+      }
+    }
+    return;
+  }
+
+  // the residuals take at most 10 bytes per value
+  const std::vector<char> residuals = decompressLz4(data, size, 10 * nValues);
+  std::vector<std::int64_t> multiples(nValues);
+  std::size_t position = 0;
+  for (std::size_t index = begin; index < end; index++)
+  {
+    std::uint64_t zigzag = 0;
+    for (int shift = 0; position < residuals.size(); shift += 7)
+    {
+      const unsigned char byte = residuals[position++];
+      zigzag |= std::uint64_t(byte & 0x7f) << shift;
+      if (byte < 0x80)
+        break;
+    }
+    const std::int64_t residual = std::int64_t(zigzag >> 1) ^ -std::int64_t(zigzag & 1);
+    multiples[index - begin] = residual + predict(multiples, index, begin, nComponents, rowLength);
+    const double value = multiples[index - begin] * (2 * tolerance_);
+    std::memcpy(values + index * sizeof(double), &value, sizeof(double));
+  }
+}
+
+std::vector<char> BlockCodec::compressLz4(const char *source, std::size_t size)
+{
+  std::vector<char> out;
+  out.reserve(size + size / 255 + 16);
+
+  // last position of every hash of 4 bytes, the candidates of a match
+  const int hashBits = 14;
+  std::vector<std::uint32_t> table(std::size_t(1) << hashBits, 0);
+  auto hash = [&](std::uint32_t sequence)
+  {
+    return (sequence * 2654435761u) >> (32 - hashBits);
+  };
+
+  // the format requires the last 5 bytes to be literals and the last match to start 12 bytes before the end
+  const std::size_t matchStartLimit = size > 12 ? size - 12 : 0;
+  const std::size_t matchEndLimit = size > 5 ? size - 5 : 0;
+  std::size_t anchor = 0;
+  std::size_t position = 1;
+  while (position < matchStartLimit)
+  {
+    const std::uint32_t sequence = read32(source + position);
+    const std::uint32_t hashValue = hash(sequence);
+    const std::size_t candidate = table[hashValue];
+    table[hashValue] = position;
+
+    if (position - candidate > 65535 || read32(source + candidate) != sequence)
+    {
+      position++;
+      continue;
+    }
+
+    std::size_t matchLength = 4;
+    while (position + matchLength < matchEndLimit && source[candidate + matchLength] == source[position + matchLength])
+      matchLength++;
+
+    // token, literals since the last match, offset and length of the match
+    const std::size_t literalLength = position - anchor;
+    const std::size_t matchCode = matchLength - 4;
+    out.push_back(char((std::min<std::size_t>(literalLength, 15) << 4) | std::min<std::size_t>(matchCode, 15)));
+    if (literalLength >= 15)
+      writeLength(out, literalLength - 15);
+    out.insert(out.end(), source + anchor, source + position);
+    const std::size_t offset = position - candidate;
+    out.push_back(char(offset & 0xff));
+    out.push_back(char(offset >> 8));
+    if (matchCode >= 15)
+      writeLength(out, matchCode - 15);
+
+    position += matchLength;
+    anchor = position;
+  }
+
+  // the rest are literals
+  const std::size_t literalLength = size - anchor;
+  out.push_back(char(std::min<std::size_t>(literalLength, 15) << 4));
+  if (literalLength >= 15)
+    writeLength(out, literalLength - 15);
+  out.insert(out.end(), source + anchor, source + size);
+  return out;
+}
+
+std::vector<char> BlockCodec::decompressLz4(const char *source, std::size_t size, std::size_t decompressedSize)
+{
+  const unsigned char *in = reinterpret_cast<const unsigned char *>(source);
+  std::vector<char> out;
+  out.reserve(decompressedSize);
+
+  std::size_t position = 0;
+  while (position < size)
+  {
+    const unsigned char token = in[position++];
+    std::size_t literalLength = token >> 4;
+    if (literalLength == 15)
+      literalLength += readLength(in, size, position);
+    if (position + literalLength > size || out.size() + literalLength > decompressedSize)
+      throw std::invalid_argument("Corrupt LZ4 block.");
+    out.insert(out.end(), source + position, source + position + literalLength);
+    position += literalLength;
+
+    // the last sequence has no match
+    if (position >= size)
+      break;
+
+    const std::size_t offset = in[position] | (std::size_t(in[position + 1]) << 8);
+    position += 2;
+    std::size_t matchLength = token & 15;
+    if (matchLength == 15)
+      matchLength += readLength(in, size, position);
+    matchLength += 4;
+    if (offset == 0 || offset > out.size() || out.size() + matchLength > decompressedSize)
+      throw std::invalid_argument("Corrupt LZ4 block.");
+
+    // the match may overlap the bytes it produces
+    const std::size_t matchStart = out.size() - offset;
+    for (std::size_t index = 0; index < matchLength; index++)
+      out.push_back(out[matchStart + index]);
+  }
+  return out;
+}
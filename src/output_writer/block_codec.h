@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class BlockCodec
+ * @brief Compresses the arrays of the vti files in independent blocks, in the layout of the compressed vtk files.
+ *
+ * An encoded array is a header of UInt64 values, the number of blocks, the uncompressed size of a block,
+ * the uncompressed size of the last block (0 if it is full) and the compressed size of every block,
+ * followed by the compressed blocks. The blocks are encoded in parallel.
+ *
+ * - lz4: the values are compressed with LZ4, the files are read by ParaView (compressor vtkLZ4DataCompressor).
+ * - shuffle: the bytes of the values in a block are reordered before they are compressed with LZ4, component by
+ *   component, first the first byte of all values of the component, then the second and so on. Sign, exponent and
+ *   leading mantissa bytes of smooth fields and components that are 0 then form long runs, losslessly.
+ * - lossy: only for Float64 values, the values are rounded to multiples of 2 * tolerance, the error is at most the tolerance. Every
+ *   multiple is predicted from its neighbours in the same block (the previous node and the two nodes below),
+ *   the differences are small for smooth fields and stored as variable length integers, which are compressed with LZ4.
+ *
+ * ParaView does not know the last two, the files are converted to uncompressed vti files by vti_compare/decode_vti.py.
+ */
+class BlockCodec
+{
+public:
+  //! how the values are encoded
+  enum class Method
+  {
+    none,
+    lz4,
+    shuffle,
+    lossy
+  };
+
+  /**
+   * @brief Constructor.
+   *
+   * @param method how the values are encoded
+   * @param tolerance maximum absolute error of the lossy method
+   */
+  BlockCodec(Method method = Method::none, double tolerance = 0.0);
+
+  /**
+   * @brief method given by its name in the settings: none, lz4, shuffle or lossy
+   */
+  static Method methodFromName(std::string name);
+
+  //! how the values are encoded
+  Method method() const;
+
+  //! maximum absolute error of the lossy method
+  double tolerance() const;
+
+  /**
+   * @brief value of the compressor attribute of the vti file, empty for uncompressed files
+   */
+  std::string compressorName() const;
+
+  /**
+   * @brief Encode an array of node values
+   *
+   * @param values bytes of the values of the nodes, nComponents per node, the nodes in rows
+   * @param nValues number of values
+   * @param valueSize size of a value in bytes, 8 for the lossy method
+   * @param nComponents number of values per node
+   * @param rowLength number of values in a row of nodes, the lossy method predicts from the row below
+   * @return header and compressed blocks
+   */
+  std::vector<char> encode(const char *values, std::size_t nValues, int valueSize, int nComponents, int rowLength) const;
+
+  /**
+   * @brief Decode an array encoded with the same method and tolerance, returns the bytes of the values
+   */
+  std::vector<char> decode(const char *data, std::size_t size, int valueSize, int nComponents, int rowLength) const;
+
+  /**
+   * @brief Compress bytes to an LZ4 block, without frame
+   */
+  static std::vector<char> compressLz4(const char *source, std::size_t size);
+
+  /**
+   * @brief Decompress an LZ4 block
+   *
+   * @param source compressed block
+   * @param size size of the compressed block
+   * @param decompressedSize size of the original bytes
+   */
+  static std::vector<char> decompressLz4(const char *source, std::size_t size, std::size_t decompressedSize);
+
+  static constexpr std::size_t blockSize = 1 << 16; //!< uncompressed size of a block in bytes, a multiple of the value sizes
+
+private:
+  //! encode the bytes of values [begin, end) of an array
+  std::vector<char> encodeBlock(const char *values, std::size_t begin, std::size_t end, int valueSize,
+                                int nComponents, int rowLength) const;
+
+  //! decode a block to the values [begin, end) of an array
+  void decodeBlock(const char *data, std::size_t size, char *values, std::size_t begin, std::size_t end,
+                   int valueSize, int nComponents, int rowLength) const;
+
+  Method method_;    //!< how the values are encoded
+  double tolerance_; //!< maximum absolute error of the lossy method
+};
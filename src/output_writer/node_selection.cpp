@@ -0,0 +1,105 @@
+#include "node_selection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+  //! a / b rounded down and up, for any sign of a and b > 0
+  int divideFloor(int a, int b)
+  {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+  }
+
+  int divideCeil(int a, int b)
+  {
+    return -divideFloor(-a, b);
+  }
+}
+
+NodeSelection::NodeSelection(const Partitioning &partitioning, std::array<double, 2> meshWidth, std::vector<double> region,
+                             int stride, bool sharedEdges) :
+  meshWidth_(meshWidth),
+  stride_(stride)
+{
+  if (stride_ < 1)
+    throw std::invalid_argument("The output stride has to be at least 1.");
+  if (!region.empty() && region.size() != 4)
+    throw std::invalid_argument("The output region has to be given as x0,y0,x1,y1.");
+
+  const std::array<int, 2> nCellsGlobal = partitioning.nCellsGlobal();
+  const std::array<int, 2> nCells = partitioning.nCellsLocal();
+  const std::array<int, 2> nodeOffset = partitioning.nodeOffset();
+  const std::array<bool, 2> containsUpperBoundary = {partitioning.ownPartitionContainsRightBoundary(),
+                                                     partitioning.ownPartitionContainsTopBoundary()};
+
+  for (int d = 0; d < 2; d++)
+  {
+    // global indices of the nodes in the region, nodes on its edges within rounding are included
+    int first = 0;
+    int last = nCellsGlobal[d];
+    if (!region.empty())
+    {
+      first = std::max(first, int(std::ceil(region[d] / meshWidth_[d] - 1e-9)));
+      last = std::min(last, int(std::floor(region[d + 2] / meshWidth_[d] + 1e-9)));
+    }
+    if (last < first)
+      throw std::invalid_argument("The output region contains no node of the mesh.");
+
+    // own nodes, the nodes on the upper edge belong to the upper neighbour unless they are shared
+    const int ownFirst = nodeOffset[d];
+    const int ownLast = nodeOffset[d] + nCells[d] - (sharedEdges || containsUpperBoundary[d] ? 0 : 1);
+
+    wholeExtent_[2 * d] = 0;
+    wholeExtent_[2 * d + 1] = (last - first) / stride_;
+    extent_[2 * d] = std::max(0, divideCeil(ownFirst - first, stride_));
+    extent_[2 * d + 1] = std::min(wholeExtent_[2 * d + 1], divideFloor(ownLast - first, stride_));
+    firstNode_[d] = first + extent_[2 * d] * stride_ - nodeOffset[d];
+    origin_[d] = first * meshWidth_[d];
+  }
+}
+
+bool NodeSelection::isEmpty() const
+{
+  return extent_[1] < extent_[0] || extent_[3] < extent_[2];
+}
+
+std::array<int, 4> NodeSelection::wholeExtent() const
+{
+  return wholeExtent_;
+}
+
+std::array<int, 4> NodeSelection::extent() const
+{
+  return extent_;
+}
+
+std::array<int, 2> NodeSelection::nPoints() const
+{
+  if (isEmpty())
+    return {0, 0};
+  return {extent_[1] - extent_[0] + 1, extent_[3] - extent_[2] + 1};
+}
+
+std::array<double, 2> NodeSelection::origin() const
+{
+  return origin_;
+}
+
+std::array<double, 2> NodeSelection::spacing() const
+{
+  return {stride_ * meshWidth_[0], stride_ * meshWidth_[1]};
+}
+
+int NodeSelection::stride() const
+{
+  return stride_;
+}
+
+IndexRange NodeSelection::rows(int rowBegin, int rowEnd) const
+{
+  const std::array<int, 2> nPoints = this->nPoints();
+  return {firstNode_[0], firstNode_[0] + (nPoints[0] - 1) * stride_ + 1,
+          firstNode_[1] + rowBegin * stride_, firstNode_[1] + (rowEnd - 1) * stride_ + 1};
+}
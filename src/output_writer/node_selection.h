@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../parallel/partitioning.h"
+#include "../storage/iteration.h"
+
+#include <array>
+#include <vector>
+
+/**
+ * @class NodeSelection
+ * @brief The nodes of the mesh that an output contains: the nodes in a region of interest, every stride-th of them.
+ *
+ * The region is a box [x0,x1] x [y0,y1] in physical coordinates, it selects the nodes of the mesh inside of it.
+ * Of these, every stride-th node in x and y direction is selected, starting at the lower left one, such that the
+ * selected nodes form a coarser mesh with the mesh width stride * h. The selected nodes of the whole domain are
+ * numbered from 0 in the output, the origin of the output is the position of the lower left selected node.
+ *
+ * Every rank selects the nodes of its own subdomain. The nodes on the upper edges of a subdomain are shared with
+ * the neighbour, they are either contained in both pieces or only in the upper one. Ranks without selected nodes
+ * do not take part in the output.
+ */
+class NodeSelection
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param partitioning partitioning of the domain into the subdomains of the ranks
+   * @param meshWidth mesh width in x and y direction
+   * @param region x0,y0,x1,y1 of the box of the selected nodes, empty for the whole domain
+   * @param stride every stride-th node of the region is selected, 1 for all
+   * @param sharedEdges if the nodes on the upper edges of the subdomain are also selected by this rank,
+   *                    otherwise only by the upper neighbour
+   */
+  NodeSelection(const Partitioning &partitioning, std::array<double, 2> meshWidth, std::vector<double> region = {},
+                int stride = 1, bool sharedEdges = true);
+
+  /**
+   * @brief if no node of the own subdomain is selected
+   */
+  bool isEmpty() const;
+
+  //! first and last index of the selected nodes of the whole domain in x and y direction, the first is 0
+  std::array<int, 4> wholeExtent() const;
+
+  //! first and last index of the own selected nodes in x and y direction
+  std::array<int, 4> extent() const;
+
+  //! number of own selected nodes in x and y direction
+  std::array<int, 2> nPoints() const;
+
+  //! position of the selected node with index (0,0)
+  std::array<double, 2> origin() const;
+
+  //! distance between two selected nodes in x and y direction
+  std::array<double, 2> spacing() const;
+
+  //! every stride-th node is selected
+  int stride() const;
+
+  /**
+   * @brief local node indices of the own selected nodes of the rows [rowBegin, rowEnd), to be interpolated with
+   *        stride(), rows are counted from 0 at the first own selected row
+   */
+  IndexRange rows(int rowBegin, int rowEnd) const;
+
+private:
+  std::array<int, 4> wholeExtent_;  //!< first and last index of the selected nodes of the whole domain
+  std::array<int, 4> extent_;       //!< first and last index of the own selected nodes
+  std::array<int, 2> firstNode_;    //!< local node index of the own selected node with index (extent_[0], extent_[2])
+  std::array<double, 2> origin_;    //!< position of the selected node with index (0,0)
+  std::array<double, 2> meshWidth_; //!< mesh width of the simulation
+  int stride_;                      //!< every stride-th node is selected
+};
@@ -0,0 +1,71 @@
+#include "output_schedule.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+OutputSchedule::OutputSchedule(const OutputCadence &cadence) :
+  cadence_(cadence),
+  nextIntervalNo_(1),
+  nextTimeIndex_(0),
+  wasSteady_(false)
+{
+}
+
+bool OutputSchedule::isEnabled() const
+{
+  return cadence_.interval > 0 || cadence_.stepInterval > 0 || !cadence_.times.empty() || cadence_.onSteadyState;
+}
+
+bool OutputSchedule::isDue(double currentTime, int stepNo, bool steadyStateReached)
+{
+  bool isDue = false;
+
+  if (cadence_.stepInterval > 0 && stepNo % cadence_.stepInterval == 0)
+    isDue = true;
+
+  // a long time step may pass several output times, they are all covered by this output
+  if (cadence_.interval > 0)
+  {
+    while (hasReached(currentTime, nextIntervalNo_ * cadence_.interval))
+    {
+      isDue = true;
+      nextIntervalNo_++;
+    }
+  }
+  while (nextTimeIndex_ < cadence_.times.size() && hasReached(currentTime, cadence_.times[nextTimeIndex_]))
+  {
+    isDue = true;
+    nextTimeIndex_++;
+  }
+
+  if (cadence_.onSteadyState && steadyStateReached && !wasSteady_)
+    isDue = true;
+  wasSteady_ = steadyStateReached;
+
+  return isDue;
+}
+
+double OutputSchedule::clampTimeStepWidth(double currentTime, double dt) const
+{
+  const double outputTime = nextOutputTime();
+  if (!hasReached(outputTime, currentTime + dt) && outputTime > currentTime)
+    return outputTime - currentTime;
+  return dt;
+}
+
+double OutputSchedule::nextOutputTime() const
+{
+  double outputTime = std::numeric_limits<double>::infinity();
+  if (cadence_.interval > 0)
+    outputTime = nextIntervalNo_ * cadence_.interval;
+  if (nextTimeIndex_ < cadence_.times.size())
+    outputTime = std::min(outputTime, cadence_.times[nextTimeIndex_]);
+  return outputTime;
+}
+
+bool OutputSchedule::hasReached(double time, double outputTime)
+{
+  const double tolerance = 1e-9 * std::max(1.0, std::abs(outputTime));
+  return time >= outputTime - tolerance;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../settings_parser/settings.h"
+
+#include <cstddef>
+
+/**
+ * @class OutputSchedule
+ * @brief Decides after which time steps a writer writes, from the triggers of its OutputCadence.
+ *
+ * A writer writes after a time step if any trigger fires: every stepInterval time steps, when a multiple
+ * of interval or one of the explicit times is reached, or once when the velocities become steady.
+ * The time steps can be shortened with clampTimeStepWidth, so that the output times are hit exactly.
+ * Times that differ by less than a relative tolerance count as equal, so that rounding in the
+ * accumulated simulation time neither causes tiny time steps nor misses an output.
+ */
+class OutputSchedule
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param cadence triggers of the writer, the explicit times have to be sorted, by default none
+   */
+  OutputSchedule(const OutputCadence &cadence = OutputCadence());
+
+  /**
+   * @brief if any trigger is set, i.e. the writer writes at all
+   */
+  bool isEnabled() const;
+
+  /**
+   * @brief if the writer writes after the current time step, call once after every time step
+   *
+   * @param currentTime simulated time at the end of the time step
+   * @param stepNo number of time steps done, starting at 1
+   * @param steadyStateReached if the velocities are steady, the output is written when this becomes true
+   */
+  bool isDue(double currentTime, int stepNo, bool steadyStateReached);
+
+  /**
+   * @brief shorten a time step that would pass the next time of an output, so that it ends on that time
+   *
+   * @param currentTime simulated time at the beginning of the time step
+   * @param dt time step width
+   * @return time step width that does not pass the next output time
+   */
+  double clampTimeStepWidth(double currentTime, double dt) const;
+
+private:
+  /**
+   * @brief next time of an interval or explicit output, infinity if there is none
+   */
+  double nextOutputTime() const;
+
+  //! if the time is at or after the output time, within the tolerance
+  static bool hasReached(double time, double outputTime);
+
+  OutputCadence cadence_;     //!< triggers of the writer
+  int nextIntervalNo_;        //!< the next interval output is at nextIntervalNo_ * interval
+  std::size_t nextTimeIndex_; //!< index of the next explicit output time
+  bool wasSteady_;            //!< if the velocities were steady after the previous time step
+};
@@ -1,6 +1,10 @@
 #include "output_writer.h"
 
-OutputWriter::OutputWriter(std::shared_ptr<Discretization> discretization)
+#include <cassert>
+#include <cstdint>
+
+template <typename T>
+OutputWriter<T>::OutputWriter(std::shared_ptr<StaggeredGrid<T>> discretization)
     : discretization_(discretization), fileNo_(0)
 {
   // create "out" subdirectory if it does not yet exist
@@ -8,3 +12,41 @@ OutputWriter::OutputWriter(std::shared_ptr<Discretization> discretization)
   if (returnValue != 0)
     std::cout << "Could not create subdirectory \"out\"." << std::endl;
 }
+
+template <typename T>
+void OutputWriter<T>::setDiscretization(std::shared_ptr<StaggeredGrid<T>> discretization)
+{
+  assert(discretization->nCells() == discretization_->nCells());
+  discretization_ = discretization;
+}
+
+template <typename T>
+void OutputWriter<T>::interpolateToNodes(const FieldVariable<T> &field, IndexRange nodes, char *destination, int stride,
+                                         VtiFile::Precision precision, const VtiFile::Array &array, int nodeStride)
+{
+  switch (precision)
+  {
+  case VtiFile::Precision::float32:
+    field.interpolateToNodes(nodes, reinterpret_cast<float *>(destination), stride, 0.0, 1.0, nodeStride);
+    break;
+  case VtiFile::Precision::quantized16:
+    field.interpolateToNodes(nodes, reinterpret_cast<std::uint16_t *>(destination), stride, array.offset, array.scale, nodeStride);
+    break;
+  default:
+    field.interpolateToNodes(nodes, reinterpret_cast<double *>(destination), stride, 0.0, 1.0, nodeStride);
+  }
+}
+
+template <typename T>
+void OutputWriter<T>::setQuantization(VtiFile::Array &array, double absMax)
+{
+  // a field of zeros is stored as the value in the middle
+  if (!(absMax > 0))
+    absMax = 1.0;
+  array.offset = -absMax;
+  array.scale = absMax / quantizedZero;
+}
+
+// scalar types used for the field storage
+template class OutputWriter<float>;
+template class OutputWriter<double>;
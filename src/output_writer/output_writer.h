@@ -1,14 +1,19 @@
 #pragma once
 
-#include "../discretization/discretization.h"
+#include "../discretization/staggered_grid.h"
+#include "vti_file.h"
 
+#include <cstdint>
 #include <memory>
 #include <iostream>
 
 /**
  * @class OutputWriter
  * @brief Inteface class for writing simulation data output.
+ *
+ * @tparam T scalar type used to store the field variables
  */
+template <typename T = double>
 class OutputWriter
 {
 public:
@@ -17,7 +22,10 @@ public:
    *
    * @param discretization discretization object containing data to be written to file
    */
-  OutputWriter(std::shared_ptr<Discretization> discretization);
+  OutputWriter(std::shared_ptr<StaggeredGrid<T>> discretization);
+
+  //! writers are owned through the interface
+  virtual ~OutputWriter() = default;
 
   /**
    * @brief Write current velocities to file.
@@ -28,7 +36,38 @@ public:
    */
   virtual void writeFile(double currentTime) = 0;
 
+  /**
+   * @brief Write the values of another discretization of the same shape from now on, e.g. a snapshot,
+   *        writers that wrap another writer pass it on
+   */
+  virtual void setDiscretization(std::shared_ptr<StaggeredGrid<T>> discretization);
+
 protected:
-  std::shared_ptr<Discretization> discretization_; //!< shared pointer, discretization object containing data to be written to file
-  int fileNo_;                                     //!< a counter that increments for every file written to disk
+  /**
+   * @brief Interpolate a field at a range of nodes into values of the output precision, see FieldVariable::interpolateToNodes
+   *
+   * @param field field variable to interpolate
+   * @param nodes range of node indices
+   * @param destination bytes of the values, the value of the first node is at the start
+   * @param stride distance between two nodes in values, e.g. 3 for the components of a vector
+   * @param precision type of the values
+   * @param array offset and scale of quantized values
+   * @param nodeStride only every nodeStride-th node of the range in x and y direction
+   */
+  static void interpolateToNodes(const FieldVariable<T> &field, IndexRange nodes, char *destination, int stride,
+                                 VtiFile::Precision precision, const VtiFile::Array &array, int nodeStride = 1);
+
+  /**
+   * @brief Set the offset and scale of a quantized array such that the values in [-absMax, absMax] are stored,
+   *        0 is stored exactly as quantizedZero
+   *
+   * @param array array to quantize
+   * @param absMax maximum absolute value, of all ranks such that the pieces of an output can be combined
+   */
+  static void setQuantization(VtiFile::Array &array, double absMax);
+
+  static constexpr std::uint16_t quantizedZero = 32767; //!< quantized value of 0, e.g. of the third velocity component
+
+  std::shared_ptr<StaggeredGrid<T>> discretization_; //!< shared pointer, discretization object containing data to be written to file
+  int fileNo_;                                       //!< a counter that increments for every file written to disk
 };
@@ -0,0 +1,121 @@
+#include "output_writer_async.h"
+#include "../storage/iteration.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+template <typename T>
+OutputWriterAsync<T>::OutputWriterAsync(std::shared_ptr<StaggeredGrid<T>> discretization, std::unique_ptr<OutputWriter<T>> writer,
+                                        std::vector<int> cores, int nThreads, int nSnapshots)
+    : OutputWriter<T>(discretization),
+      writer_(std::move(writer)),
+      cores_(std::move(cores)),
+      nThreads_(nThreads),
+      stop_(false)
+{
+  assert(nThreads >= 1);
+  assert(nSnapshots >= 1);
+  for (int snapshot = 0; snapshot < nSnapshots; snapshot++)
+  {
+    snapshots_.push_back(std::make_shared<StaggeredGrid<T>>(discretization_->nCells(), discretization_->meshWidth(),
+                                                            discretization_->partitioning(), false));
+    freeSnapshots_.push_back(snapshot);
+  }
+  thread_ = std::thread(&OutputWriterAsync<T>::writeSnapshots, this);
+}
+
+template <typename T>
+OutputWriterAsync<T>::~OutputWriterAsync()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queued_.notify_one();
+  thread_.join();
+}
+
+template <typename T>
+void OutputWriterAsync<T>::writeFile(double currentTime)
+{
+  // back-pressure: wait until the I/O thread has written one of the snapshots
+  int snapshot;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_.wait(lock, [&]()
+                  { return !freeSnapshots_.empty(); });
+    snapshot = freeSnapshots_.back();
+    freeSnapshots_.pop_back();
+  }
+
+  // copy the values with all threads, the ghost layers are needed for the interpolation
+  auto copy = [](const FieldVariable<T> &source, FieldVariable<T> &target)
+  {
+    const FieldView<const T> from = source.view();
+    const FieldView<T> to = target.view();
+    forEachInterior({0, source.size()[0], 0, source.size()[1]}, [&](int i, int j)
+                    { to(i, j) = from(i, j); }, IterationPolicy::independent());
+  };
+  copy(discretization_->u(), snapshots_[snapshot]->u());
+  copy(discretization_->v(), snapshots_[snapshot]->v());
+  copy(discretization_->p(), snapshots_[snapshot]->p());
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.emplace_back(snapshot, currentTime);
+  }
+  queued_.notify_one();
+}
+
+template <typename T>
+void OutputWriterAsync<T>::writeSnapshots()
+{
+#ifdef __linux__
+  // the thread was started by the master, which may be bound to a single core of the simulation
+  if (!cores_.empty())
+  {
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    for (int core : cores_)
+      CPU_SET(core, &cores);
+    sched_setaffinity(0, sizeof(cores), &cores);
+  }
+#endif
+
+#ifdef _OPENMP
+  // the own team of this thread runs on its cores, the cores of the simulation's threads are not used
+  omp_set_num_threads(nThreads_);
+#endif
+
+  while (true)
+  {
+    std::pair<int, double> entry;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queued_.wait(lock, [&]()
+                   { return !queue_.empty() || stop_; });
+      if (queue_.empty())
+        return;
+      entry = queue_.front();
+      queue_.pop_front();
+    }
+
+    writer_->setDiscretization(snapshots_[entry.first]);
+    writer_->writeFile(entry.second);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      freeSnapshots_.push_back(entry.first);
+    }
+    written_.notify_one();
+  }
+}
+
+// scalar types used for the field storage
+template class OutputWriterAsync<float>;
+template class OutputWriterAsync<double>;
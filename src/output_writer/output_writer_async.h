@@ -0,0 +1,72 @@
+#pragma once
+
+#include "output_writer.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @class OutputWriterAsync
+ * @brief Writes the output of another writer on a background thread while the simulation continues.
+ *
+ * writeFile copies u, v and p into a free snapshot and returns, the I/O thread lets the wrapped
+ * writer interpolate and write the snapshots in the order of the calls. A snapshot is a grid
+ * without f, g and rhs, the wrapped writer may only read u, v and p. The snapshots are recycled,
+ * if all of them are still waiting to be written, writeFile blocks until one is free (back-pressure).
+ * The wrapped writer is only used by the I/O thread, if it calls MPI, MPI_THREAD_MULTIPLE is required
+ * and it has to communicate on its own communicator. The I/O thread binds itself to the given cores,
+ * otherwise it would inherit the single core of the master thread if the thread pool is pinned. Its OpenMP
+ * team, e.g. for the blocks of BlockCodec::encode, has nThreads threads on these cores.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class OutputWriterAsync : public OutputWriter<T>
+{
+public:
+  /**
+   * @brief Constructor, starts the I/O thread
+   *
+   * @param discretization discretization whose values are written
+   * @param writer writer that writes the snapshots
+   * @param cores cores the I/O thread runs on, e.g. ThreadPool::ioCores, empty: those of the creating thread
+   * @param nThreads size of the OpenMP team of the I/O thread, e.g. ThreadPool::nIoThreads
+   * @param nSnapshots number of snapshots, 2: one is written while the next one is filled
+   */
+  OutputWriterAsync(std::shared_ptr<StaggeredGrid<T>> discretization, std::unique_ptr<OutputWriter<T>> writer,
+                    std::vector<int> cores = {}, int nThreads = 1, int nSnapshots = 2);
+
+  //! write the remaining snapshots and stop the I/O thread
+  ~OutputWriterAsync();
+
+  /**
+   * @brief Copy the current values to a snapshot and queue it to be written
+   *
+   * @param currentTime current time in simulation
+   */
+  void writeFile(double currentTime);
+
+private:
+  //! loop of the I/O thread
+  void writeSnapshots();
+
+  using OutputWriter<T>::discretization_;
+
+  std::unique_ptr<OutputWriter<T>> writer_;                 //!< writes the snapshots, only used by the I/O thread
+  std::vector<int> cores_;                                  //!< cores the I/O thread runs on, empty: not bound
+  int nThreads_;                                            //!< size of the OpenMP team of the I/O thread
+  std::vector<std::shared_ptr<StaggeredGrid<T>>> snapshots_; //!< copies of u, v and p that are written
+  std::vector<int> freeSnapshots_;                          //!< snapshots that can be filled
+  std::deque<std::pair<int, double>> queue_;                //!< snapshots to write and their time, oldest first
+  bool stop_;                                               //!< set when the I/O thread should end after the queue
+
+  std::mutex mutex_;                   //!< protects freeSnapshots_, queue_ and stop_
+  std::condition_variable queued_;     //!< signalled when a snapshot is queued or the thread should stop
+  std::condition_variable written_;    //!< signalled when a snapshot is free again
+  std::thread thread_;                 //!< I/O thread
+};
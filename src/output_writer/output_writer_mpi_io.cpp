@@ -0,0 +1,163 @@
+#include "output_writer_mpi_io.h"
+#include "vti_file.h"
+#include "../parallel/task_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+
+template <typename T>
+OutputWriterMpiIo<T>::OutputWriterMpiIo(std::shared_ptr<StaggeredGrid<T>> discretization, NodeSelection selection,
+                                        VtiFile::Precision precision)
+    : OutputWriter<T>(discretization),
+      selection_(selection),
+      arrays_({{"pressure", 1}, {"velocity", 3}}),
+      precision_(precision)
+{
+  // only the ranks with selected nodes open the files
+  const Partitioning &partitioning = *discretization_->partitioning();
+  MPI_Comm_split(partitioning.communicator(), selection_.isEmpty() ? MPI_UNDEFINED : 0, partitioning.ownRankNo(), &communicator_);
+  if (selection_.isEmpty())
+    return;
+
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  const std::size_t nOwnPoints = std::size_t(nPoints[0]) * nPoints[1];
+  const int valueSize = VtiFile::valueSize(precision_);
+  p_.resize(valueSize * nOwnPoints);
+  velocity_.resize(3 * valueSize * nOwnPoints, 0);
+  valueType_ = precision_ == VtiFile::Precision::float32       ? MPI_FLOAT
+               : precision_ == VtiFile::Precision::quantized16 ? MPI_UINT16_T
+                                                                 : MPI_DOUBLE;
+  if (precision_ == VtiFile::Precision::quantized16)
+  {
+    for (std::size_t index = 0; index < nOwnPoints; index++)
+      reinterpret_cast<std::uint16_t *>(velocity_.data())[3 * index + 2] = this->quantizedZero;
+  }
+
+  // the arrays of the file are stored row by row, j is the slowest index
+  const std::array<int, 4> wholeExtent = selection_.wholeExtent();
+  const std::array<int, 4> extent = selection_.extent();
+  const std::array<int, 2> sizes = {wholeExtent[3] + 1, wholeExtent[1] + 1};
+  const std::array<int, 2> subsizes = {nPoints[1], nPoints[0]};
+  const std::array<int, 2> starts = {extent[2], extent[0]};
+  MPI_Type_create_subarray(2, sizes.data(), subsizes.data(), starts.data(), MPI_ORDER_C, valueType_, &pressureView_);
+  MPI_Type_commit(&pressureView_);
+
+  const std::array<int, 3> vectorSizes = {sizes[0], sizes[1], 3};
+  const std::array<int, 3> vectorSubsizes = {subsizes[0], subsizes[1], 3};
+  const std::array<int, 3> vectorStarts = {starts[0], starts[1], 0};
+  MPI_Type_create_subarray(3, vectorSizes.data(), vectorSubsizes.data(), vectorStarts.data(), MPI_ORDER_C, valueType_, &velocityView_);
+  MPI_Type_commit(&velocityView_);
+}
+
+template <typename T>
+OutputWriterMpiIo<T>::~OutputWriterMpiIo()
+{
+  if (selection_.isEmpty())
+    return;
+  MPI_Type_free(&pressureView_);
+  MPI_Type_free(&velocityView_);
+  MPI_Comm_free(&communicator_);
+}
+
+template <typename T>
+void OutputWriterMpiIo<T>::interpolateData()
+{
+  // fields and bands of rows are independent tasks, the nodes on the upper edges are interpolated from the ghost layers
+  const int rowsPerTask = 64;
+  const int valueSize = VtiFile::valueSize(precision_);
+  const int stride = selection_.stride();
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  TaskGraph graph;
+  for (int jBegin = 0; jBegin < nPoints[1]; jBegin += rowsPerTask)
+  {
+    const IndexRange band = selection_.rows(jBegin, std::min(jBegin + rowsPerTask, nPoints[1]));
+    const std::size_t first = std::size_t(valueSize) * jBegin * nPoints[0];
+    graph.add([this, band, first, stride]()
+              { this->interpolateToNodes(discretization_->p(), band, &p_[first], 1, precision_, arrays_[0], stride); });
+    graph.add([this, band, first, stride]()
+              { this->interpolateToNodes(discretization_->u(), band, &velocity_[3 * first], 3, precision_, arrays_[1], stride); });
+    graph.add([this, band, first, stride, valueSize]()
+              { this->interpolateToNodes(discretization_->v(), band, &velocity_[3 * first + valueSize], 3, precision_, arrays_[1], stride); });
+  }
+  graph.run();
+}
+
+template <typename T>
+void OutputWriterMpiIo<T>::writeFile(double currentTime)
+{
+  // ranks without selected nodes do not take part
+  if (selection_.isEmpty())
+  {
+    fileNo_++;
+    return;
+  }
+
+  // the node values lie between the stored values, the largest ones of all ranks bound the quantized values
+  if (precision_ == VtiFile::Precision::quantized16)
+  {
+    std::array<double, 2> absMax = {discretization_->p().findAbsMax(),
+                                    std::max(discretization_->u().findAbsMax(), discretization_->v().findAbsMax())};
+    MPI_Allreduce(MPI_IN_PLACE, absMax.data(), 2, MPI_DOUBLE, MPI_MAX, communicator_);
+    this->setQuantization(arrays_[0], absMax[0]);
+    this->setQuantization(arrays_[1], absMax[1]);
+  }
+
+  interpolateData();
+
+  // Assemble the filename
+  std::stringstream fileName;
+  fileName << "out/output_" << std::setw(4) << std::setfill('0') << fileNo_ << ".vti";
+
+  // increment file no.
+  fileNo_++;
+
+  // layout of the file: header, size and values of the pressure, size and values of the velocity, footer
+  const std::array<int, 4> wholeExtent = selection_.wholeExtent();
+  const std::string headerText = VtiFile::header(wholeExtent, wholeExtent, selection_.origin(), selection_.spacing(),
+                                                 currentTime, arrays_, precision_);
+  const std::string footer = VtiFile::footer();
+  const std::uint64_t nPointsGlobal = std::uint64_t(wholeExtent[1] + 1) * (wholeExtent[3] + 1);
+  const std::uint64_t pressureBytes = VtiFile::valueSize(precision_) * nPointsGlobal;
+  const std::uint64_t velocityBytes = 3 * VtiFile::valueSize(precision_) * nPointsGlobal;
+  const MPI_Offset pressureOffset = headerText.size() + sizeof(std::uint64_t);
+  const MPI_Offset velocityOffset = pressureOffset + pressureBytes + sizeof(std::uint64_t);
+  const MPI_Offset footerOffset = velocityOffset + velocityBytes;
+
+  int ownRankNo;
+  MPI_Comm_rank(communicator_, &ownRankNo);
+  MPI_File file;
+  if (MPI_File_open(communicator_, fileName.str().c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                    MPI_INFO_NULL, &file) != MPI_SUCCESS)
+  {
+    if (ownRankNo == 0)
+      std::cout << "Could not write to file \"" << fileName.str() << "\"." << std::endl;
+    return;
+  }
+
+  // a previous, larger file of the same name is cut off
+  MPI_File_set_size(file, footerOffset + footer.size());
+
+  // the first rank with selected nodes writes the XML and the sizes of the arrays
+  if (ownRankNo == 0)
+  {
+    MPI_File_write_at(file, 0, headerText.data(), headerText.size(), MPI_CHAR, MPI_STATUS_IGNORE);
+    MPI_File_write_at(file, pressureOffset - sizeof(std::uint64_t), &pressureBytes, sizeof(std::uint64_t), MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_write_at(file, velocityOffset - sizeof(std::uint64_t), &velocityBytes, sizeof(std::uint64_t), MPI_BYTE, MPI_STATUS_IGNORE);
+    MPI_File_write_at(file, footerOffset, footer.data(), footer.size(), MPI_CHAR, MPI_STATUS_IGNORE);
+  }
+
+  // all ranks write their nodes into the arrays at once
+  const int valueSize = VtiFile::valueSize(precision_);
+  MPI_File_set_view(file, pressureOffset, valueType_, pressureView_, "native", MPI_INFO_NULL);
+  MPI_File_write_at_all(file, 0, p_.data(), p_.size() / valueSize, valueType_, MPI_STATUS_IGNORE);
+  MPI_File_set_view(file, velocityOffset, valueType_, velocityView_, "native", MPI_INFO_NULL);
+  MPI_File_write_at_all(file, 0, velocity_.data(), velocity_.size() / valueSize, valueType_, MPI_STATUS_IGNORE);
+
+  MPI_File_close(&file);
+}
+
+// scalar types used for the field storage
+template class OutputWriterMpiIo<float>;
+template class OutputWriterMpiIo<double>;
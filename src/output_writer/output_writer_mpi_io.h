@@ -0,0 +1,72 @@
+#pragma once
+
+#include "output_writer.h"
+#include "node_selection.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class OutputWriterMpiIo
+ * @brief Write one *.vti file per output that all ranks write to collectively with MPI-IO, can be viewed with ParaView.
+ *
+ * The file is a vtk image data file of the whole computational domain with the values in a raw appended
+ * section, i.e. the XML header that describes the mesh and the arrays is followed by the binary arrays.
+ * Rank 0 writes the header, every rank writes the values at its own nodes into the arrays with a
+ * subarray file view given by the node offset of its subdomain. The header is the one of VtiFile. The nodes on the edges to the
+ * neighbours belong to the upper neighbour. No VTK library is needed and only one file per output is created.
+ * The values are interpolated directly into the precision of the output. Only the nodes of a NodeSelection are
+ * written, the ranks without selected nodes neither open the file nor write to it.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class OutputWriterMpiIo : public OutputWriter<T>
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param discretization shared pointer to the discretization of the own subdomain
+   * @param selection nodes to write, without shared edges
+   * @param precision type of the stored values
+   */
+  OutputWriterMpiIo(std::shared_ptr<StaggeredGrid<T>> discretization, NodeSelection selection,
+                    VtiFile::Precision precision = VtiFile::Precision::float64);
+
+  //! free the file views and the communicator
+  ~OutputWriterMpiIo();
+
+  /**
+   * @brief Write current velocities and pressure, filename is output_<count>.vti
+   *
+   * @param currentTime current time in simulation
+   */
+  void writeFile(double currentTime);
+
+private:
+  /**
+   * @brief interpolate p and the velocity at the own nodes
+   */
+  void interpolateData();
+
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
+
+  NodeSelection selection_; //!< nodes to write, the nodes on the upper edges of the subdomain only on the ranks at the boundary
+
+  std::vector<VtiFile::Array> arrays_; //!< pressure and velocity
+  VtiFile::Precision precision_;       //!< type of the stored values
+  MPI_Datatype valueType_;             //!< MPI type of a stored value
+
+  MPI_Comm communicator_;     //!< own communicator of the ranks with selected nodes, such that the writer may run on another thread
+  MPI_Datatype pressureView_; //!< own nodes in the pressure array of the file
+  MPI_Datatype velocityView_; //!< own nodes in the velocity array of the file, three components per node
+
+  std::vector<char> p_;        //!< p at the own nodes, in the output precision
+  std::vector<char> velocity_; //!< u, v and 0 at the own nodes, in the output precision
+};
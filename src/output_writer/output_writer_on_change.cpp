@@ -0,0 +1,103 @@
+#include "output_writer_on_change.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+template <typename T>
+OutputWriterOnChange<T>::OutputWriterOnChange(std::shared_ptr<StaggeredGrid<T>> discretization,
+                                              std::unique_ptr<OutputWriter<T>> writer, NodeSelection selection,
+                                              double threshold)
+    : OutputWriter<T>(discretization),
+      writer_(std::move(writer)),
+      selection_(selection),
+      threshold_(threshold),
+      hasReference_(false)
+{
+  const Partitioning &partitioning = *discretization_->partitioning();
+  MPI_Comm_dup(partitioning.communicator(), &communicator_);
+
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  for (std::vector<float> *values : {&referenceU_, &referenceV_, &referenceP_, &candidateU_, &candidateV_, &candidateP_})
+    values->resize(std::size_t(nPoints[0]) * nPoints[1]);
+
+  if (partitioning.ownRankNo() == 0)
+  {
+    indexFile_.open("out/output_index.csv", std::ios::out);
+    indexFile_ << "t, change, file" << std::endl;
+  }
+}
+
+template <typename T>
+OutputWriterOnChange<T>::~OutputWriterOnChange()
+{
+  MPI_Comm_free(&communicator_);
+}
+
+template <typename T>
+void OutputWriterOnChange<T>::setDiscretization(std::shared_ptr<StaggeredGrid<T>> discretization)
+{
+  OutputWriter<T>::setDiscretization(discretization);
+  writer_->setDiscretization(discretization);
+}
+
+template <typename T>
+void OutputWriterOnChange<T>::compare(const FieldVariable<T> &field, const std::vector<float> &reference,
+                                      std::vector<float> &candidate, double &maxChange, double &maxValue) const
+{
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  for (int j = 0; j < nPoints[1]; j++)
+  {
+    const std::size_t rowStart = std::size_t(j) * nPoints[0];
+    field.interpolateToNodes(selection_.rows(j, j + 1), candidate.data() + rowStart, 1, 0.0, 1.0, selection_.stride());
+
+    if (!hasReference_)
+      continue;
+    for (std::size_t k = rowStart; k < rowStart + nPoints[0]; k++)
+    {
+      maxChange = std::max(maxChange, double(std::fabs(candidate[k] - reference[k])));
+      maxValue = std::max(maxValue, double(std::max(std::fabs(candidate[k]), std::fabs(reference[k]))));
+    }
+  }
+}
+
+template <typename T>
+void OutputWriterOnChange<T>::writeFile(double currentTime)
+{
+  // maximum change and value of the velocity and the pressure
+  double local[4] = {0.0, 0.0, 0.0, 0.0};
+  compare(discretization_->u(), referenceU_, candidateU_, local[0], local[1]);
+  compare(discretization_->v(), referenceV_, candidateV_, local[0], local[1]);
+  compare(discretization_->p(), referenceP_, candidateP_, local[2], local[3]);
+
+  double global[4];
+  MPI_Allreduce(local, global, 4, MPI_DOUBLE, MPI_MAX, communicator_);
+  const double change = std::max(global[1] > 0 ? global[0] / global[1] : 0.0,
+                                 global[3] > 0 ? global[2] / global[3] : 0.0);
+
+  // the first output has no reference and is always written
+  const bool isWritten = !hasReference_ || change > threshold_;
+  if (isWritten)
+  {
+    writer_->writeFile(currentTime);
+    std::swap(referenceU_, candidateU_);
+    std::swap(referenceV_, candidateV_);
+    std::swap(referenceP_, candidateP_);
+    hasReference_ = true;
+  }
+
+  if (indexFile_.is_open())
+  {
+    indexFile_ << currentTime << ", " << change << ", ";
+    if (isWritten)
+      indexFile_ << fileNo_ << std::endl;
+    else
+      indexFile_ << "skipped" << std::endl;
+  }
+  if (isWritten)
+    fileNo_++;
+}
+
+// scalar types used for the field storage
+template class OutputWriterOnChange<float>;
+template class OutputWriterOnChange<double>;
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "output_writer.h"
+#include "node_selection.h"
+
+#include <mpi.h>
+
+#include <fstream>
+#include <memory>
+#include <vector>
+
+/**
+ * @class OutputWriterOnChange
+ * @brief Lets another writer write an output only if the solution has changed enough since the last written one.
+ *
+ * The wrapper keeps the values of u, v and p at the selected nodes of the last written output as float. For every
+ * output it interpolates the current values row by row and compares every row with the reference while it is in the
+ * cache. The change is the largest difference of a node value relative to the largest absolute value, the maximum of
+ * the velocity and the pressure: max |u - u_ref|, |v - v_ref| / max |u|, |v|, |u_ref|, |v_ref| and the same for p.
+ * The ranks agree on the change, the output is written if it exceeds the threshold or if no output has been written
+ * yet, and the written values become the new reference.
+ *
+ * Rank 0 records every output in out/output_index.csv: the time, the change and the number of the written file
+ * or "skipped". The wrapper communicates on its own communicator.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class OutputWriterOnChange : public OutputWriter<T>
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param discretization discretization whose values are written
+   * @param writer writer that writes the outputs that have changed enough
+   * @param selection nodes at which the change is measured, e.g. the nodes that the writer writes
+   * @param threshold smallest relative change of an output that is written
+   */
+  OutputWriterOnChange(std::shared_ptr<StaggeredGrid<T>> discretization, std::unique_ptr<OutputWriter<T>> writer,
+                       NodeSelection selection, double threshold);
+
+  //! free the communicator
+  ~OutputWriterOnChange();
+
+  /**
+   * @brief Let the writer write the current values if they have changed by more than the threshold
+   *
+   * @param currentTime current time in simulation
+   */
+  void writeFile(double currentTime);
+
+  /**
+   * @brief Compare and write the values of another discretization from now on, e.g. a snapshot
+   */
+  void setDiscretization(std::shared_ptr<StaggeredGrid<T>> discretization) override;
+
+private:
+  /**
+   * @brief Interpolate a field at the selected nodes into candidate and compare it with reference in the same pass
+   *
+   * @param field field variable to interpolate
+   * @param reference values of the last written output
+   * @param candidate values of the current output
+   * @param maxChange maximum absolute difference to the reference, updated
+   * @param maxValue maximum absolute value of the output and the reference, updated
+   */
+  void compare(const FieldVariable<T> &field, const std::vector<float> &reference, std::vector<float> &candidate,
+               double &maxChange, double &maxValue) const;
+
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
+
+  std::unique_ptr<OutputWriter<T>> writer_; //!< writer of the outputs that have changed enough
+  NodeSelection selection_;                 //!< nodes at which the change is measured
+  double threshold_;                        //!< smallest relative change of an output that is written
+  MPI_Comm communicator_;                   //!< own communicator, the change is reduced on it
+  std::ofstream indexFile_;                 //!< on rank 0: times of the written and skipped outputs
+  bool hasReference_;                       //!< if an output has been written, on all ranks
+
+  std::vector<float> referenceU_;  //!< u at the selected nodes of the last written output
+  std::vector<float> referenceV_;  //!< v at the selected nodes of the last written output
+  std::vector<float> referenceP_;  //!< p at the selected nodes of the last written output
+  std::vector<float> candidateU_;  //!< u at the selected nodes of the current output
+  std::vector<float> candidateV_;  //!< v at the selected nodes of the current output
+  std::vector<float> candidateP_;  //!< p at the selected nodes of the current output
+};
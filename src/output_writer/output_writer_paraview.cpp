@@ -1,126 +1,88 @@
 #include "output_writer_paraview.h"
 
-OutputWriterParaview::OutputWriterParaview(std::shared_ptr<Discretization> discretization) : OutputWriter(discretization)
+template <typename T>
+OutputWriterParaview<T>::OutputWriterParaview(std::shared_ptr<StaggeredGrid<T>> discretization) : OutputWriter<T>(discretization)
 {
   // Create a vtkWriter_
   vtkWriter_ = vtkSmartPointer<vtkXMLImageDataWriter>::New();
-}
-
-void OutputWriterParaview::writeFile(double currentTime)
-{
-  // Assemble the filename
-  std::stringstream fileName;
-  fileName << "out/output_" << std::setw(4) << setfill('0') << fileNo_ << "." << vtkWriter_->GetDefaultFileExtension();
-
-  // increment file no.
-  fileNo_++;
-
-  // assign the new file name to the output vtkWriter_
-  vtkWriter_->SetFileName(fileName.str().c_str());
 
-  // initialize data set that will be output to the file
-  vtkSmartPointer<vtkImageData> dataSet = vtkSmartPointer<vtkImageData>::New();
-  dataSet->SetOrigin(0, 0, 0);
+  // initialize data set that will be output to the files, only the values and the time change between them
+  dataSet_ = vtkSmartPointer<vtkImageData>::New();
+  dataSet_->SetOrigin(0, 0, 0);
 
   // set spacing of mesh
   const double dx = discretization_->meshWidth()[0];
   const double dy = discretization_->meshWidth()[1];
   const double dz = 1;
-  dataSet->SetSpacing(dx, dy, dz);
+  dataSet_->SetSpacing(dx, dy, dz);
 
   // set number of points in each dimension, 1 cell in z direction
   std::array<int, 2> nCells = discretization_->nCells();
   // we want to have points at each corner of each cell
-  dataSet->SetDimensions(nCells[0] + 1, nCells[1] + 1, 1);
-
-  // add pressure field variable
-  // ---------------------------
-  vtkSmartPointer<vtkDoubleArray> arrayPressure = vtkDoubleArray::New();
-
-  // the pressure is a scalar which means the number of components is 1
-  arrayPressure->SetNumberOfComponents(1);
-
-  // Set the number of pressure values and allocate memory for it. We already know the number, it has to be the same as there are nodes in the mesh.
-  arrayPressure->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  dataSet_->SetDimensions(nCells[0] + 1, nCells[1] + 1, 1);
 
-  arrayPressure->SetName("pressure");
+  p_.resize(dataSet_->GetNumberOfPoints());
+  velocity_.resize(3 * dataSet_->GetNumberOfPoints());
 
-  // loop over the nodes of the mesh and assign the interpolated p values in the vtk data structure
-  // we only consider the cells that are the actual computational domain, not the helper values in the "halo"
-
-  // index for the vtk data structure, will be incremented in the inner loop
-  int index = 0;
-  for (int j = 0; j < nCells[1] + 1; j++)
-  {
-    for (int i = 0; i < nCells[0] + 1; i++, index++)
-    {
-      const double x = i * dx;
-      const double y = j * dy;
-      arrayPressure->SetValue(index, discretization_->p().interpolateAt(x, y));
-    }
-  }
-
-  // now, we should have added as many values as there are points in the vtk data structure
-  assert(index == dataSet->GetNumberOfPoints());
-
-  // add the field variable to the data set
-  dataSet->GetPointData()->AddArray(arrayPressure);
-
-  // add velocity field variable
-  // ---------------------------
-  vtkSmartPointer<vtkDoubleArray> arrayVelocity = vtkDoubleArray::New();
+  // the pressure is a scalar which means the number of components is 1,
+  // the array refers to p_, save = 1: vtk does not free it
+  arrayPressure_ = vtkSmartPointer<vtkDoubleArray>::New();
+  arrayPressure_->SetName("pressure");
+  arrayPressure_->SetNumberOfComponents(1);
+  arrayPressure_->SetArray(p_.data(), p_.size(), 1);
+  dataSet_->GetPointData()->AddArray(arrayPressure_);
 
   // here we have two components (u,v), but ParaView will only allow vector glyphs if we have an ℝ^3 vector,
   // therefore we use a 3-dimensional vector and set the 3rd component to zero
-  arrayVelocity->SetNumberOfComponents(3);
-
-  // set the number of values
-  arrayVelocity->SetNumberOfTuples(dataSet->GetNumberOfPoints());
+  arrayVelocity_ = vtkSmartPointer<vtkDoubleArray>::New();
+  arrayVelocity_->SetName("velocity");
+  arrayVelocity_->SetNumberOfComponents(3);
+  arrayVelocity_->SetArray(velocity_.data(), velocity_.size(), 1);
+  dataSet_->GetPointData()->AddArray(arrayVelocity_);
 
-  arrayVelocity->SetName("velocity");
+  // current time
+  arrayTime_ = vtkSmartPointer<vtkDoubleArray>::New();
+  arrayTime_->SetName("TIME");
+  arrayTime_->SetNumberOfTuples(1);
+  dataSet_->GetFieldData()->AddArray(arrayTime_);
 
-  // loop over the mesh where p is defined and assign the values in the vtk data structure
-  // index for the vtk data structure
-  index = 0;
-  for (int j = 0; j < nCells[1] + 1; j++)
-  {
-    const double y = j * dy;
+  vtkWriter_->SetInputData(dataSet_);
 
-    for (int i = 0; i < nCells[0] + 1; i++, index++)
-    {
-      const double x = i * dx;
-
-      std::array<double, 3> velocityVector;
-      velocityVector[0] = discretization_->u().interpolateAt(x, y);
-      velocityVector[1] = discretization_->v().interpolateAt(x, y);
-      velocityVector[2] = 0.0; // z-direction is 0
-
-      arrayVelocity->SetTuple(index, velocityVector.data());
-    }
-  }
-  // now, we should have added as many values as there are points in the vtk data structure
-  assert(index == dataSet->GetNumberOfPoints());
+  // vtkWriter_->SetDataModeToAscii();     // comment this in to get ascii text files: those can be checked in an editor
+  //  set file mode to binary files: smaller file sizes
+  vtkWriter_->SetDataModeToBinary();
+}
 
-  // add the field variable to the data set
-  dataSet->GetPointData()->AddArray(arrayVelocity);
+template <typename T>
+void OutputWriterParaview<T>::writeFile(double currentTime)
+{
+  // Assemble the filename
+  std::stringstream fileName;
+  fileName << "out/output_" << std::setw(4) << setfill('0') << fileNo_ << "." << vtkWriter_->GetDefaultFileExtension();
 
-  // add current time
-  vtkSmartPointer<vtkDoubleArray> arrayTime = vtkDoubleArray::New();
-  arrayTime->SetName("TIME");
-  arrayTime->SetNumberOfTuples(1);
-  arrayTime->SetTuple1(0, currentTime);
-  dataSet->GetFieldData()->AddArray(arrayTime);
+  // increment file no.
+  fileNo_++;
 
-  // Remove unused memory
-  dataSet->Squeeze();
+  // assign the new file name to the output vtkWriter_
+  vtkWriter_->SetFileName(fileName.str().c_str());
 
-  // Write the data
-  vtkWriter_->SetInputData(dataSet);
+  // interpolate p and the velocity at the nodes of the mesh into the memory of the vtk arrays,
+  // the 3rd component of the velocity stays zero
+  std::array<int, 2> nCells = discretization_->nCells();
+  const IndexRange nodes = {0, nCells[0] + 1, 0, nCells[1] + 1};
+  discretization_->p().interpolateToNodes(nodes, p_.data());
+  discretization_->u().interpolateToNodes(nodes, &velocity_[0], 3);
+  discretization_->v().interpolateToNodes(nodes, &velocity_[1], 3);
 
-  // vtkWriter_->SetDataModeToAscii();     // comment this in to get ascii text files: those can be checked in an editor
-  //  set file mode to binary files: smaller file sizes
-  vtkWriter_->SetDataModeToBinary();
+  arrayTime_->SetTuple1(0, currentTime);
+  arrayPressure_->Modified();
+  arrayVelocity_->Modified();
+  arrayTime_->Modified();
 
   // finally write out the data
   vtkWriter_->Write();
-}
\ No newline at end of file
+}
+
+// scalar types used for the field storage
+template class OutputWriterParaview<float>;
+template class OutputWriterParaview<double>;
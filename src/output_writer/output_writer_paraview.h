@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <iostream>
+#include <vector>
 
 /**
  * @class OutputWriterParaview
@@ -18,8 +19,12 @@
  * The mesh that can be visualized in ParaView corresponds to the mesh of the computational domain.
  * All values are given for the nodes of the mesh, i.e., the corners of each cell.
  * This means, values will be interpolated because the values are stored at positions given by the staggered grid.
+ * The vtk data set and its arrays are created once, the values are interpolated directly into the memory of the arrays.
+ *
+ * @tparam T scalar type used to store the field variables
  */
-class OutputWriterParaview : public OutputWriter
+template <typename T = double>
+class OutputWriterParaview : public OutputWriter<T>
 {
 public:
   /**
@@ -27,7 +32,7 @@ public:
    *
    * @param discretization shared pointer to the discretization object that will contain all the data to be written to the file
    */
-  OutputWriterParaview(std::shared_ptr<Discretization> discretization);
+  OutputWriterParaview(std::shared_ptr<StaggeredGrid<T>> discretization);
 
   /**
    * @brief Write current velocities to file, filename is output_<count>.vti
@@ -37,5 +42,15 @@ public:
   void writeFile(double currentTime);
 
 private:
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
+
   vtkSmartPointer<vtkXMLImageDataWriter> vtkWriter_; //!< vtk writer to write ImageData
+  vtkSmartPointer<vtkImageData> dataSet_;            //!< mesh of the domain with the arrays below
+  vtkSmartPointer<vtkDoubleArray> arrayPressure_;    //!< pressure array, refers to p_
+  vtkSmartPointer<vtkDoubleArray> arrayVelocity_;    //!< velocity array, refers to velocity_
+  vtkSmartPointer<vtkDoubleArray> arrayTime_;        //!< current time as field data
+
+  std::vector<double> p_;        //!< p at the nodes
+  std::vector<double> velocity_; //!< u, v and 0 at the nodes, in the order of the vtk array
 };
@@ -1,204 +1,141 @@
-#include "output_writer/output_writer_paraview_parallel.h"
+#include "output_writer_paraview_parallel.h"
+#include "vti_file.h"
+#include "../parallel/task_graph.h"
 
-#include "storage/field_variable.h"
-#include "discretization/1_discretization.h"
-
-#include <vtkImageData.h>
-#include <vtkDoubleArray.h>
-#include <vtkPointData.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include <mpi.h>
 
-OutputWriterParaviewParallel::OutputWriterParaviewParallel(std::shared_ptr<Discretization> discretization, const Partitioning &partitioning) :
-   OutputWriter(discretization, partitioning),
-
-  nCellsGlobal_(partitioning_.nCellsGlobal()),
-  nPointsGlobal_ {nCellsGlobal_[0]+1, nCellsGlobal_[1]+1},    // we have one point more than cells in every coordinate direction
-  
-  // create field variables for resulting values, only for local data as send buffer
-  u_(nPointsGlobal_, std::array<double,2>{0.,0.}, discretization_->meshWidth()),
-  v_(nPointsGlobal_, std::array<double,2>{0.,0.}, discretization_->meshWidth()),
-  p_(nPointsGlobal_, std::array<double,2>{0.,0.}, discretization_->meshWidth()),
-  
-  // create field variables for resulting values, after MPI communication
-  uGlobal_(nPointsGlobal_, std::array<double,2>{0.,0.}, discretization_->meshWidth()),
-  vGlobal_(nPointsGlobal_, std::array<double,2>{0.,0.}, discretization_->meshWidth()),
-  pGlobal_(nPointsGlobal_, std::array<double,2>{0.,0.}, discretization_->meshWidth())
+template <typename T>
+OutputWriterParaviewParallel<T>::OutputWriterParaviewParallel(std::shared_ptr<StaggeredGrid<T>> discretization)
+    : OutputWriter<T>(discretization),
+      nCellsGlobal_(discretization->partitioning()->nCellsGlobal())
 {
   // Create a vtkWriter_
   vtkWriter_ = vtkSmartPointer<vtkXMLImageDataWriter>::New();
+
+  // we have one point more than cells in every coordinate direction, the upper nodes are shared with the neighbour
+  const Partitioning &partitioning = *discretization_->partitioning();
+  const std::array<int, 2> nCells = discretization_->nCells();
+  const std::array<int, 2> nodeOffset = partitioning.nodeOffset();
+  nPoints_ = {nCells[0] + 1, nCells[1] + 1};
+  extent_ = {nodeOffset[0], nodeOffset[0] + nCells[0], nodeOffset[1], nodeOffset[1] + nCells[1]};
+
+  const int nPoints = nPoints_[0] * nPoints_[1];
+  p_.resize(nPoints);
+  velocity_.resize(3 * nPoints);
+
+  // the data set does not change between the files, only the values in p_ and velocity_ and the time
+  dataSet_ = vtkSmartPointer<vtkImageData>::New();
+  dataSet_->SetOrigin(0, 0, 0);
+  dataSet_->SetSpacing(discretization_->meshWidth()[0], discretization_->meshWidth()[1], 1);
+
+  // global node indices of the own piece, 1 cell in z direction
+  dataSet_->SetExtent(extent_[0], extent_[1], extent_[2], extent_[3], 0, 0);
+
+  // the arrays refer to the memory of the writer, save = 1: vtk does not free it
+  arrayPressure_ = vtkSmartPointer<vtkDoubleArray>::New();
+  arrayPressure_->SetName("pressure");
+  arrayPressure_->SetNumberOfComponents(1);
+  arrayPressure_->SetArray(p_.data(), p_.size(), 1);
+  dataSet_->GetPointData()->AddArray(arrayPressure_);
+
+  // ParaView only shows vector glyphs of vectors in ℝ^3, the 3rd component is zero
+  arrayVelocity_ = vtkSmartPointer<vtkDoubleArray>::New();
+  arrayVelocity_->SetName("velocity");
+  arrayVelocity_->SetNumberOfComponents(3);
+  arrayVelocity_->SetArray(velocity_.data(), velocity_.size(), 1);
+  dataSet_->GetPointData()->AddArray(arrayVelocity_);
+
+  arrayTime_ = vtkSmartPointer<vtkDoubleArray>::New();
+  arrayTime_->SetName("TIME");
+  arrayTime_->SetNumberOfTuples(1);
+  dataSet_->GetFieldData()->AddArray(arrayTime_);
+
+  vtkWriter_->SetInputData(dataSet_);
+
+  // set file mode to binary files: smaller file sizes
+  vtkWriter_->SetDataModeToBinary();
+
+  // the extents do not change, rank 0 collects them once for all pvti files
+  if (partitioning.ownRankNo() == 0)
+    pieceExtents_.resize(partitioning.nRanks());
+  MPI_Gather(extent_.data(), 4, MPI_INT, pieceExtents_.data(), 4, MPI_INT, 0, partitioning.communicator());
 }
 
-void OutputWriterParaviewParallel::gatherData()
+template <typename T>
+void OutputWriterParaviewParallel<T>::interpolateData()
 {
- // std::array<int,2> size, std::array<double,2> origin, std::array<double,2> meshWidth
-
-  int nPointsGlobalTotal = nPointsGlobal_[0] * nPointsGlobal_[1];
-  const double dx = discretization_->meshWidth()[0];
-  const double dy = discretization_->meshWidth()[1];
-
-  // set values in own subdomain, other values are left at zero
-
-  // determine data range {0,…,iEnd-1} x {0,…,jEnd-1}
-  std::array<int,2> nCells = discretization_->nCells();
-  int jEnd = nCells[1];
-  int iEnd = nCells[0];
-
-  // add right-most points at ranks with right boundary
-  if (partitioning_.ownPartitionContainsRightBoundary())
-    iEnd += 1;
-
-  // add right-most points at ranks with top boundary
-  if (partitioning_.ownPartitionContainsTopBoundary())
-    jEnd += 1;
-
-  std::array<int,2> nodeOffset = partitioning_.nodeOffset();
-
-  u_.setToZero();
-  v_.setToZero();
-  p_.setToZero();
-
-  for (int j = 0; j < jEnd; j++)
+  // fields and bands of rows are independent tasks, the nodes on the upper edges are interpolated from the ghost layers
+  const int rowsPerTask = 64;
+  TaskGraph graph;
+  for (int jBegin = 0; jBegin < nPoints_[1]; jBegin += rowsPerTask)
   {
-    for (int i = 0; i < iEnd; i++)
-    {
-      const double x = i*dx;
-      const double y = j*dy;
-
-      // get global indices
-      int iGlobal = nodeOffset[0] + i;
-      int jGlobal = nodeOffset[1] + j;
-
-      u_(iGlobal,jGlobal) = discretization_->u().interpolateAt(x,y);
-      v_(iGlobal,jGlobal) = discretization_->v().interpolateAt(x,y);
-      p_(iGlobal,jGlobal) = discretization_->p().interpolateAt(x,y);
-    }
+    const IndexRange band = {0, nPoints_[0], jBegin, std::min(jBegin + rowsPerTask, nPoints_[1])};
+    const std::size_t first = std::size_t(jBegin) * nPoints_[0];
+    graph.add([this, band, first]()
+              { discretization_->p().interpolateToNodes(band, &p_[first]); });
+    graph.add([this, band, first]()
+              { discretization_->u().interpolateToNodes(band, &velocity_[3 * first], 3); });
+    graph.add([this, band, first]()
+              { discretization_->v().interpolateToNodes(band, &velocity_[3 * first + 1], 3); });
   }
+  graph.run();
+}
+
+template <typename T>
+std::string OutputWriterParaviewParallel<T>::pieceFileName(int fileNo, int rankNo) const
+{
+  std::stringstream fileName;
+  fileName << "output_" << std::setw(4) << setfill('0') << fileNo << "." << rankNo << "." << vtkWriter_->GetDefaultFileExtension();
+  return fileName.str();
+}
+
+template <typename T>
+void OutputWriterParaviewParallel<T>::writeMasterFile(int fileNo) const
+{
+  std::stringstream fileName;
+  fileName << "out/output_" << std::setw(4) << setfill('0') << fileNo << ".pvti";
 
-  // sum up values from all ranks, not set values are zero
-  MPI_Reduce(u_.data(), uGlobal_.data(), nPointsGlobalTotal, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-  MPI_Reduce(v_.data(), vGlobal_.data(), nPointsGlobalTotal, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-  MPI_Reduce(p_.data(), pGlobal_.data(), nPointsGlobalTotal, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  std::vector<std::string> pieceFileNames;
+  for (int rankNo = 0; rankNo < int(pieceExtents_.size()); rankNo++)
+    pieceFileNames.push_back(pieceFileName(fileNo, rankNo));
 
+  const std::array<int, 4> wholeExtent = {0, nCellsGlobal_[0], 0, nCellsGlobal_[1]};
+  VtiFile::writeMasterFile(fileName.str(), wholeExtent, {0.0, 0.0}, discretization_->meshWidth(), {{"pressure", 1}, {"velocity", 3}},
+                           pieceExtents_, pieceFileNames);
 }
 
-void OutputWriterParaviewParallel::writeFile(double currentTime)
+template <typename T>
+void OutputWriterParaviewParallel<T>::writeFile(double currentTime)
 {
-  // communicate all data to rank 0
-  gatherData();
+  interpolateData();
 
-  // only continue to write the file on rank 0
-  if (partitioning_.ownRankNo() != 0)
-  {
-    return;
-  }
+  const int ownRankNo = discretization_->partitioning()->ownRankNo();
+  if (ownRankNo == 0)
+    writeMasterFile(fileNo_);
 
   // Assemble the filename
   std::stringstream fileName;
-  fileName << "out/output_" << std::setw(4) << setfill('0') << fileNo_ << "." << vtkWriter_->GetDefaultFileExtension();
-  
+  fileName << "out/" << pieceFileName(fileNo_, ownRankNo);
+
   // increment file no.
   fileNo_++;
 
   // assign the new file name to the output vtkWriter_
   vtkWriter_->SetFileName(fileName.str().c_str());
-  
-  // initialize data set that will be output to the file
-  vtkSmartPointer<vtkImageData> dataSet = vtkSmartPointer<vtkImageData>::New();
-  dataSet->SetOrigin(0, 0, 0);
-
-  // set spacing of mesh
-  const double dx = discretization_->meshWidth()[0];
-  const double dy = discretization_->meshWidth()[1];
-  const double dz = 1;
-  dataSet->SetSpacing(dx, dy, dz);
-
-  // set number of points in each dimension, 1 cell in z direction
-  dataSet->SetDimensions(nCellsGlobal_[0]+1, nCellsGlobal_[1]+1, 1);  // we want to have points at each corner of each cell
-  
-
-  // add pressure field variable
-  // ---------------------------
-  vtkSmartPointer<vtkDoubleArray> arrayPressure = vtkDoubleArray::New();
-
-  // the pressure is a scalar which means the number of components is 1
-  arrayPressure->SetNumberOfComponents(1);
-
-  // Set the number of pressure values and allocate memory for it. We already know the number, it has to be the same as there are nodes in the mesh.
-  arrayPressure->SetNumberOfTuples(dataSet->GetNumberOfPoints());
-  
-  arrayPressure->SetName("pressure");
-
-  // loop over the nodes of the mesh and assign the interpolated p values in the vtk data structure
-  // we only consider the cells that are the actual computational domain, not the helper values in the "halo"
-
-  int index = 0;   // index for the vtk data structure, will be incremented in the inner loop
-  for (int j = 0; j < nCellsGlobal_[1]+1; j++)
-  {
-    for (int i = 0; i < nCellsGlobal_[0]+1; i++, index++)
-    {
-      arrayPressure->SetValue(index, pGlobal_(i,j));
-    }
-  }
-
-  // now, we should have added as many values as there are points in the vtk data structure
-  assert(index == dataSet->GetNumberOfPoints());
-
-  // add the field variable to the data set
-  dataSet->GetPointData()->AddArray(arrayPressure);
-  
-  // add velocity field variable
-  // ---------------------------
-  vtkSmartPointer<vtkDoubleArray> arrayVelocity = vtkDoubleArray::New();
-
-  // here we have two components (u,v), but ParaView will only allow vector glyphs if we have an ℝ^3 vector, 
-  // therefore we use a 3-dimensional vector and set the 3rd component to zero
-  arrayVelocity->SetNumberOfComponents(3);
 
-  // set the number of values
-  arrayVelocity->SetNumberOfTuples(dataSet->GetNumberOfPoints());
-  
-  arrayVelocity->SetName("velocity");
-
-  // loop over the mesh where p is defined and assign the values in the vtk data structure
-  index = 0;   // index for the vtk data structure
-  for (int j = 0; j < nCellsGlobal_[1]+1; j++)
-  {
-    const double y = j*dy;
-
-    for (int i = 0; i < nCellsGlobal_[0]+1; i++, index++)
-    {
-      const double x = i*dx;
-
-      std::array<double,3> velocityVector;
-      velocityVector[0] = uGlobal_(i,j);
-      velocityVector[1] = vGlobal_(i,j);
-      velocityVector[2] = 0.0;    // z-direction is 0
-
-      arrayVelocity->SetTuple(index, velocityVector.data());
-    }
-  }
-  // now, we should have added as many values as there are points in the vtk data structure
-  assert(index == dataSet->GetNumberOfPoints());
-
-  // add the field variable to the data set
-  dataSet->GetPointData()->AddArray(arrayVelocity);
-  
-  // add current time 
-  vtkSmartPointer<vtkDoubleArray> arrayTime = vtkDoubleArray::New();
-  arrayTime->SetName("TIME");
-  arrayTime->SetNumberOfTuples(1);
-  arrayTime->SetTuple1(0, currentTime);
-  dataSet->GetFieldData()->AddArray(arrayTime);
-
-  // Remove unused memory
-  dataSet->Squeeze();
-  
-  // Write the data
-  vtkWriter_->SetInputData(dataSet);
-  
-  //vtkWriter_->SetDataModeToAscii();     // comment this in to get ascii text files: those can be checked in an editor
-  vtkWriter_->SetDataModeToBinary();      // set file mode to binary files: smaller file sizes
+  // the values have been interpolated into the memory of the arrays
+  arrayTime_->SetTuple1(0, currentTime);
+  arrayPressure_->Modified();
+  arrayVelocity_->Modified();
+  arrayTime_->Modified();
 
   // finally write out the data
   vtkWriter_->Write();
-}
\ No newline at end of file
+}
+
+// scalar types used for the field storage
+template class OutputWriterParaviewParallel<float>;
+template class OutputWriterParaviewParallel<double>;
@@ -1,43 +1,82 @@
 #pragma once
 
-#include "output_writer/output_writer.h"
-#include "discretization/1_discretization.h"
+#include "output_writer.h"
 
 #include <vtkSmartPointer.h>
 #include <vtkXMLImageDataWriter.h>
+#include <vtkImageData.h>
+#include <vtkDoubleArray.h>
+#include <vtkPointData.h>
 
+#include <array>
 #include <memory>
+#include <string>
+#include <vector>
 
-/** Write *.vti files that can be viewed with ParaView.
- *  The mesh that can be visualized in ParaView corresponds to the mesh of the computational domain.
- *  All values are given for the nodes of the mesh, i.e., the corners of each cell.
- *  This means, values will be interpolated because the values are stored at positions given by the staggered grid.
+/**
+ * @class OutputWriterParaviewParallel
+ * @brief Write *.vti pieces of all ranks and a *.pvti file that combines them, can be viewed with ParaView.
+ *
+ * Every rank interpolates the values at the nodes of its subdomain and writes them to its own piece
+ * output_<count>.<rank>.vti, the nodes on the edges to the neighbours are contained in both pieces.
+ * Rank 0 additionally writes output_<count>.pvti, which lists the pieces and their extents in the mesh
+ * of the whole computational domain. Memory and file size per rank only depend on the subdomain.
+ * The vtk data set and its arrays are created once, the arrays use the memory of the interpolated values
+ * without copying them, so writing a file allocates nothing.
+ *
+ * @tparam T scalar type used to store the field variables
  */
-class OutputWriterParaviewParallel : 
-  public OutputWriter
+template <typename T = double>
+class OutputWriterParaviewParallel : public OutputWriter<T>
 {
 public:
-  //! constructor
-  OutputWriterParaviewParallel(std::shared_ptr<Discretization> discretization, const Partitioning &partitioning);
+  /**
+   * @brief Constructor.
+   *
+   * @param discretization shared pointer to the discretization of the own subdomain
+   */
+  OutputWriterParaviewParallel(std::shared_ptr<StaggeredGrid<T>> discretization);
 
-  //! write current velocities to file, filename is output_<count>.vti
+  /**
+   * @brief Write current velocities to the own piece, rank 0 also writes the pvti file, filename is output_<count>.pvti
+   *
+   * @param currentTime current time in simulation
+   */
   void writeFile(double currentTime);
 
 private:
+  /**
+   * @brief interpolate u, v and p at the nodes of the own piece
+   */
+  void interpolateData();
 
-  //! gather u,v and p values from all ranks to rank 0 and store them in the global field variables
-  void gatherData();
+  /**
+   * @brief write the pvti file that refers to the pieces of all ranks, only on rank 0
+   *
+   * @param fileNo number of the output
+   */
+  void writeMasterFile(int fileNo) const;
 
-  vtkSmartPointer<vtkXMLImageDataWriter> vtkWriter_;   //< vtk writer to write ImageData
+  /**
+   * @brief file name of a piece without directory, relative to the pvti file
+   */
+  std::string pieceFileName(int fileNo, int rankNo) const;
 
-  std::array<int,2> nCellsGlobal_;   //< global number of cells
-  std::array<int,2> nPointsGlobal_;  //< global number of points
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
 
-  FieldVariable u_;    // field variable for u with global size, contains only the local values, other entries are 0
-  FieldVariable v_;    // field variable for v with global size, contains only the local values, other entries are 0
-  FieldVariable p_;    // field variable for p with global size, contains only the local values, other entries are 0
+  vtkSmartPointer<vtkXMLImageDataWriter> vtkWriter_; //!< vtk writer to write ImageData
+  vtkSmartPointer<vtkImageData> dataSet_;            //!< mesh of the own piece with the arrays below
+  vtkSmartPointer<vtkDoubleArray> arrayPressure_;    //!< pressure array, refers to p_
+  vtkSmartPointer<vtkDoubleArray> arrayVelocity_;    //!< velocity array, refers to velocity_
+  vtkSmartPointer<vtkDoubleArray> arrayTime_;        //!< current time as field data
 
-  FieldVariable uGlobal_;    // on rank 0: field variable for u that gathers values from all ranks, on other ranks: nullptr
-  FieldVariable vGlobal_;    // on rank 0: field variable for v that gathers values from all ranks, on other ranks: nullptr
-  FieldVariable pGlobal_;    // on rank 0: field variable for p that gathers values from all ranks, on other ranks: nullptr
+  std::array<int, 2> nCellsGlobal_; //!< global number of cells
+  std::array<int, 2> nPoints_;      //!< number of nodes of the own piece, including the nodes on the upper edges
+  std::array<int, 4> extent_;       //!< first and last global node index of the own piece in x and y direction
+
+  std::vector<std::array<int, 4>> pieceExtents_; //!< on rank 0: extents of the pieces of all ranks
+
+  std::vector<double> p_;        //!< p at the nodes of the own piece
+  std::vector<double> velocity_; //!< u, v and 0 at the nodes of the own piece, in the order of the vtk array
 };
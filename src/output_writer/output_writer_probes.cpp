@@ -0,0 +1,84 @@
+#include "output_writer_probes.h"
+
+#include <stdexcept>
+#include <mpi.h>
+
+template <typename T>
+OutputWriterProbes<T>::OutputWriterProbes(std::shared_ptr<StaggeredGrid<T>> discretization, std::vector<std::array<double, 2>> probes) :
+  OutputWriter<T>(discretization),
+  probes_(probes),
+  localProbes_(probes.size()),
+  isOwnProbe_(probes.size()),
+  values_(3 * probes.size())
+{
+  const Partitioning &partitioning = *discretization_->partitioning();
+  const std::array<int, 2> nodeOffset = partitioning.nodeOffset();
+  const std::array<int, 2> nCells = discretization_->nCells();
+  const std::array<int, 2> nCellsGlobal = partitioning.nCellsGlobal();
+  const std::array<double, 2> meshWidth = discretization_->meshWidth();
+
+  // a probe on the edge between two subdomains belongs to the upper one, on the upper boundary to the last one
+  const std::array<bool, 2> containsUpperBoundary = {partitioning.ownPartitionContainsRightBoundary(),
+                                                     partitioning.ownPartitionContainsTopBoundary()};
+  for (std::size_t probeNo = 0; probeNo < probes_.size(); probeNo++)
+  {
+    bool isOwn = true;
+    for (int dimension = 0; dimension < 2; dimension++)
+    {
+      const double x = probes_[probeNo][dimension];
+      if (x < 0 || x > nCellsGlobal[dimension] * meshWidth[dimension])
+        throw std::invalid_argument("probe is outside of the domain.");
+
+      const double lower = nodeOffset[dimension] * meshWidth[dimension];
+      const double upper = (nodeOffset[dimension] + nCells[dimension]) * meshWidth[dimension];
+      isOwn = isOwn && x >= lower && (x < upper || (x <= upper && containsUpperBoundary[dimension]));
+      localProbes_[probeNo][dimension] = x - lower;
+    }
+    isOwnProbe_[probeNo] = isOwn;
+  }
+
+  if (partitioning.ownRankNo() == 0)
+  {
+    file_.open("out/probes.csv", std::ios::out);
+    file_ << "t";
+    for (const std::array<double, 2> &probe : probes_)
+    {
+      for (const char *name : {"u", "v", "p"})
+        file_ << ", " << name << "(" << probe[0] << " " << probe[1] << ")";
+    }
+    file_ << std::endl;
+  }
+}
+
+template <typename T>
+void OutputWriterProbes<T>::writeFile(double currentTime)
+{
+  // the values at the probes of other ranks are zero, summing gives the value of the owner
+  for (std::size_t probeNo = 0; probeNo < probes_.size(); probeNo++)
+  {
+    const double x = localProbes_[probeNo][0];
+    const double y = localProbes_[probeNo][1];
+    const bool isOwn = isOwnProbe_[probeNo];
+    values_[3 * probeNo + 0] = isOwn ? discretization_->u().interpolateAt(x, y) : 0.0;
+    values_[3 * probeNo + 1] = isOwn ? discretization_->v().interpolateAt(x, y) : 0.0;
+    values_[3 * probeNo + 2] = isOwn ? discretization_->p().interpolateAt(x, y) : 0.0;
+  }
+
+  const Partitioning &partitioning = *discretization_->partitioning();
+  const bool isRoot = partitioning.ownRankNo() == 0;
+  MPI_Reduce(isRoot ? MPI_IN_PLACE : values_.data(), values_.data(), values_.size(), MPI_DOUBLE, MPI_SUM, 0,
+             partitioning.communicator());
+
+  if (isRoot)
+  {
+    file_ << currentTime;
+    for (double value : values_)
+      file_ << ", " << value;
+    file_ << std::endl;
+  }
+  fileNo_++;
+}
+
+// scalar types used for the field storage
+template class OutputWriterProbes<float>;
+template class OutputWriterProbes<double>;
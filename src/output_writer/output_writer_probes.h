@@ -0,0 +1,48 @@
+#pragma once
+
+#include "output_writer.h"
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+/**
+ * @class OutputWriterProbes
+ * @brief Record u, v and p at a few points over time, in out/probes.csv.
+ *
+ * Every probe is interpolated by the rank whose subdomain contains it, the values of all probes
+ * are summed on rank 0 in one message, which appends a line with the time and the values.
+ * This is much cheaper than a full output and can therefore be written much more often.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class OutputWriterProbes : public OutputWriter<T>
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param discretization shared pointer to the discretization of the own subdomain
+   * @param probes points in the coordinates of the whole domain
+   */
+  OutputWriterProbes(std::shared_ptr<StaggeredGrid<T>> discretization, std::vector<std::array<double, 2>> probes);
+
+  /**
+   * @brief Append the values at the probes at the current time
+   *
+   * @param currentTime current time in simulation
+   */
+  void writeFile(double currentTime);
+
+private:
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
+
+  std::vector<std::array<double, 2>> probes_;      //!< points in the coordinates of the whole domain
+  std::vector<std::array<double, 2>> localProbes_; //!< points relative to the own subdomain
+  std::vector<bool> isOwnProbe_;                    //!< if a probe lies in the own subdomain
+  std::vector<double> values_;                      //!< u, v and p of all probes
+  std::ofstream file_;                              //!< on rank 0: the csv file
+};
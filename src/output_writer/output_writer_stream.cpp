@@ -0,0 +1,219 @@
+#include "output_writer_stream.h"
+#include "../parallel/task_graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+template <typename T>
+OutputWriterStream<T>::OutputWriterStream(std::shared_ptr<StaggeredGrid<T>> discretization, NodeSelection selection,
+                                          VtiFile::Precision precision, int keyframeInterval)
+    : OutputWriter<T>(discretization),
+      selection_(selection),
+      arrays_({{"pressure", 1}, {"velocity", 3}}),
+      precision_(precision),
+      keyframeInterval_(keyframeInterval),
+      codec_(BlockCodec::Method::shuffle),
+      endOffset_(0)
+{
+  // only the ranks with selected nodes open the stream
+  const Partitioning &partitioning = *discretization_->partitioning();
+  MPI_Comm_split(partitioning.communicator(), selection_.isEmpty() ? MPI_UNDEFINED : 0, partitioning.ownRankNo(), &communicator_);
+  if (selection_.isEmpty())
+    return;
+
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  const std::size_t nOwnPoints = std::size_t(nPoints[0]) * nPoints[1];
+  const int valueSize = VtiFile::valueSize(precision_);
+  p_.resize(valueSize * nOwnPoints);
+  velocity_.resize(3 * valueSize * nOwnPoints, 0);
+  if (precision_ == VtiFile::Precision::quantized16)
+  {
+    for (std::size_t index = 0; index < nOwnPoints; index++)
+      reinterpret_cast<std::uint16_t *>(velocity_.data())[3 * index + 2] = this->quantizedZero;
+  }
+  previousP_ = p_;
+  previousVelocity_ = velocity_;
+  difference_.resize(velocity_.size());
+
+  // the pieces are stored in the order of the ranks
+  int ownRankNo;
+  int nRanks;
+  MPI_Comm_rank(communicator_, &ownRankNo);
+  MPI_Comm_size(communicator_, &nRanks);
+  const std::array<int, 4> extent = selection_.extent();
+  std::vector<std::array<int, 4>> pieceExtents(ownRankNo == 0 ? nRanks : 0);
+  MPI_Gather(extent.data(), 4, MPI_INT, pieceExtents.data(), 4, MPI_INT, 0, communicator_);
+
+  const std::string fileName = "out/output.stream";
+  if (MPI_File_open(communicator_, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file_) != MPI_SUCCESS)
+  {
+    if (ownRankNo == 0)
+      std::cout << "Could not write to file \"" << fileName << "\"." << std::endl;
+    file_ = MPI_FILE_NULL;
+    return;
+  }
+
+  // a previous stream of the same name is cut off
+  MPI_File_set_size(file_, 0);
+  if (ownRankNo == 0)
+  {
+    const std::string headerText = header(pieceExtents);
+    MPI_File_write_at(file_, 0, headerText.data(), headerText.size(), MPI_CHAR, MPI_STATUS_IGNORE);
+    endOffset_ = headerText.size();
+
+    index_.open("out/output.stream.index", std::ios::out);
+    index_ << "frame, t, keyframe, offset, size" << std::endl;
+  }
+  MPI_Bcast(&endOffset_, 1, MPI_OFFSET, 0, communicator_);
+}
+
+template <typename T>
+OutputWriterStream<T>::~OutputWriterStream()
+{
+  if (selection_.isEmpty())
+    return;
+  if (file_ != MPI_FILE_NULL)
+    MPI_File_close(&file_);
+  MPI_Comm_free(&communicator_);
+}
+
+template <typename T>
+std::string OutputWriterStream<T>::header(const std::vector<std::array<int, 4>> &pieceExtents) const
+{
+  const std::array<int, 4> wholeExtent = selection_.wholeExtent();
+  const std::array<double, 2> origin = selection_.origin();
+  const std::array<double, 2> spacing = selection_.spacing();
+
+  std::stringstream header;
+  header << std::setprecision(17)
+         << "numsim stream 1" << std::endl
+         << "precision " << VtiFile::typeName(precision_) << std::endl
+         << "keyframeInterval " << keyframeInterval_ << std::endl
+         << "wholeExtent " << wholeExtent[0] << " " << wholeExtent[1] << " " << wholeExtent[2] << " " << wholeExtent[3] << std::endl
+         << "origin " << origin[0] << " " << origin[1] << std::endl
+         << "spacing " << spacing[0] << " " << spacing[1] << std::endl
+         << "arrays";
+  for (const VtiFile::Array &array : arrays_)
+    header << " " << array.name << " " << array.nComponents;
+  header << std::endl
+         << "pieces " << pieceExtents.size() << std::endl;
+  for (const std::array<int, 4> &extent : pieceExtents)
+    header << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3] << std::endl;
+  header << "frames" << std::endl;
+  return header.str();
+}
+
+template <typename T>
+void OutputWriterStream<T>::interpolateData()
+{
+  // fields and bands of rows are independent tasks, the nodes on the upper edges are interpolated from the ghost layers
+  const int rowsPerTask = 64;
+  const int valueSize = VtiFile::valueSize(precision_);
+  const int stride = selection_.stride();
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  TaskGraph graph;
+  for (int jBegin = 0; jBegin < nPoints[1]; jBegin += rowsPerTask)
+  {
+    const IndexRange band = selection_.rows(jBegin, std::min(jBegin + rowsPerTask, nPoints[1]));
+    const std::size_t first = std::size_t(valueSize) * jBegin * nPoints[0];
+    graph.add([this, band, first, stride]()
+              { this->interpolateToNodes(discretization_->p(), band, &p_[first], 1, precision_, arrays_[0], stride); });
+    graph.add([this, band, first, stride]()
+              { this->interpolateToNodes(discretization_->u(), band, &velocity_[3 * first], 3, precision_, arrays_[1], stride); });
+    graph.add([this, band, first, stride, valueSize]()
+              { this->interpolateToNodes(discretization_->v(), band, &velocity_[3 * first + valueSize], 3, precision_, arrays_[1], stride); });
+  }
+  graph.run();
+}
+
+template <typename T>
+void OutputWriterStream<T>::writeFile(double currentTime)
+{
+  // ranks without selected nodes do not take part
+  if (selection_.isEmpty() || file_ == MPI_FILE_NULL)
+  {
+    fileNo_++;
+    return;
+  }
+
+  // the node values lie between the stored values, the largest ones of all ranks bound the quantized values
+  if (precision_ == VtiFile::Precision::quantized16)
+  {
+    std::array<double, 2> absMax = {discretization_->p().findAbsMax(),
+                                    std::max(discretization_->u().findAbsMax(), discretization_->v().findAbsMax())};
+    MPI_Allreduce(MPI_IN_PLACE, absMax.data(), 2, MPI_DOUBLE, MPI_MAX, communicator_);
+    this->setQuantization(arrays_[0], absMax[0]);
+    this->setQuantization(arrays_[1], absMax[1]);
+  }
+
+  interpolateData();
+
+  // between the keyframes the arrays are stored as the bits that changed since the previous frame
+  const bool isKeyframe = fileNo_ % keyframeInterval_ == 0;
+  const int valueSize = VtiFile::valueSize(precision_);
+  const int nPointsX = selection_.nPoints()[0];
+  std::vector<char> piece(2 * sizeof(std::uint64_t));
+  std::array<std::uint64_t, 2> encodedSizes;
+  for (int arrayNo = 0; arrayNo < 2; arrayNo++)
+  {
+    const std::vector<char> &values = arrayNo == 0 ? p_ : velocity_;
+    const std::vector<char> &previous = arrayNo == 0 ? previousP_ : previousVelocity_;
+    const char *source = values.data();
+    if (!isKeyframe)
+    {
+      for (std::size_t index = 0; index < values.size(); index++)
+        difference_[index] = values[index] ^ previous[index];
+      source = difference_.data();
+    }
+
+    const int nComponents = arrays_[arrayNo].nComponents;
+    const std::vector<char> encoded = codec_.encode(source, values.size() / valueSize, valueSize, nComponents,
+                                                    nComponents * nPointsX);
+    encodedSizes[arrayNo] = encoded.size();
+    piece.insert(piece.end(), encoded.begin(), encoded.end());
+  }
+  std::memcpy(piece.data(), encodedSizes.data(), sizeof(encodedSizes));
+
+  // the values of this frame are the reference of the next one, the interpolation overwrites all but the constant 3rd component
+  std::swap(p_, previousP_);
+  std::swap(velocity_, previousVelocity_);
+
+  // rank 0 writes the header of the frame in front of its piece
+  int ownRankNo;
+  MPI_Comm_rank(communicator_, &ownRankNo);
+  if (ownRankNo == 0)
+  {
+    const std::uint64_t keyframe = isKeyframe ? 1 : 0;
+    const std::array<double, 4> quantization = {arrays_[0].offset, arrays_[0].scale, arrays_[1].offset, arrays_[1].scale};
+    std::vector<char> frameHeader(sizeof(currentTime) + sizeof(keyframe) + sizeof(quantization));
+    std::memcpy(frameHeader.data(), &currentTime, sizeof(currentTime));
+    std::memcpy(frameHeader.data() + sizeof(currentTime), &keyframe, sizeof(keyframe));
+    std::memcpy(frameHeader.data() + sizeof(currentTime) + sizeof(keyframe), quantization.data(), sizeof(quantization));
+    piece.insert(piece.begin(), frameHeader.begin(), frameHeader.end());
+  }
+
+  // the pieces follow each other in the order of the ranks
+  const long long pieceSize = piece.size();
+  long long pieceOffset = 0;
+  long long frameSize = 0;
+  MPI_Exscan(&pieceSize, &pieceOffset, 1, MPI_LONG_LONG, MPI_SUM, communicator_);
+  MPI_Allreduce(&pieceSize, &frameSize, 1, MPI_LONG_LONG, MPI_SUM, communicator_);
+  if (ownRankNo == 0)
+    pieceOffset = 0;
+  MPI_File_write_at_all(file_, endOffset_ + pieceOffset, piece.data(), piece.size(), MPI_BYTE, MPI_STATUS_IGNORE);
+
+  if (index_.is_open())
+  {
+    index_ << std::setprecision(17) << fileNo_ << ", " << currentTime << ", " << (isKeyframe ? 1 : 0) << ", "
+           << endOffset_ << ", " << frameSize << std::endl;
+  }
+  endOffset_ += frameSize;
+  fileNo_++;
+}
+
+// scalar types used for the field storage
+template class OutputWriterStream<float>;
+template class OutputWriterStream<double>;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "output_writer.h"
+#include "node_selection.h"
+#include "block_codec.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class OutputWriterStream
+ * @brief Write all outputs as frames of one stream file out/output.stream, every K-th frame in full and the others
+ *        as differences to the previous frame, with an index for random access.
+ *
+ * The stream begins with a text header that describes the mesh, the precision and the pieces of the ranks, it ends
+ * with the line "frames". Every frame is a header of rank 0, the time, if it is a keyframe (UInt64) and the offsets
+ * and scales of the quantized pressure and velocity (Float64), followed by the pieces of the ranks with selected
+ * nodes in the order of the header. A piece is the encoded size of the pressure and of the velocity (UInt64) and
+ * the encoded arrays. The arrays are the values at the nodes in the precision of the output, in keyframes as they
+ * are, in the other frames XOR the values of the previous frame: the bytes that do not change, e.g. sign, exponent
+ * and leading mantissa bytes of slowly evolving fields, are zero. The arrays are encoded like the arrays of the
+ * pieces with BlockCodec::Method::shuffle, losslessly.
+ *
+ * Rank 0 lists the frames in out/output.stream.index: frame number, time, if it is a keyframe, offset and size in
+ * the stream. A frame is reconstructed from the last keyframe before it and the frames in between,
+ * vti_compare/extract_stream.py writes frames as vti files. The nodes on the edges to the neighbours belong to the
+ * upper neighbour, all ranks write their pieces of a frame collectively with MPI-IO.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class OutputWriterStream : public OutputWriter<T>
+{
+public:
+  /**
+   * @brief Constructor, writes the header of the stream
+   *
+   * @param discretization shared pointer to the discretization of the own subdomain
+   * @param selection nodes to write, without shared edges
+   * @param precision type of the stored values
+   * @param keyframeInterval every keyframeInterval-th frame is stored in full, starting with the first
+   */
+  OutputWriterStream(std::shared_ptr<StaggeredGrid<T>> discretization, NodeSelection selection,
+                     VtiFile::Precision precision = VtiFile::Precision::float64, int keyframeInterval = 10);
+
+  //! close the stream and free the communicator
+  ~OutputWriterStream();
+
+  /**
+   * @brief Append current velocities and pressure as a frame to the stream
+   *
+   * @param currentTime current time in simulation
+   */
+  void writeFile(double currentTime);
+
+private:
+  /**
+   * @brief interpolate p and the velocity at the own nodes
+   */
+  void interpolateData();
+
+  /**
+   * @brief text header of the stream
+   *
+   * @param pieceExtents extents of the pieces of the ranks with selected nodes
+   */
+  std::string header(const std::vector<std::array<int, 4>> &pieceExtents) const;
+
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
+
+  NodeSelection selection_; //!< nodes to write, the nodes on the upper edges of the subdomain only on the ranks at the boundary
+
+  std::vector<VtiFile::Array> arrays_; //!< pressure and velocity
+  VtiFile::Precision precision_;       //!< type of the stored values
+  int keyframeInterval_;               //!< every keyframeInterval_-th frame is stored in full
+  BlockCodec codec_;                   //!< encoding of the arrays
+
+  MPI_Comm communicator_; //!< own communicator of the ranks with selected nodes, such that the writer may run on another thread
+  MPI_File file_;         //!< the stream, open while the simulation runs
+  MPI_Offset endOffset_;  //!< size of the stream, the next frame begins there
+  std::ofstream index_;   //!< on rank 0: offsets of the frames
+
+  std::vector<char> p_;                //!< p at the own nodes, in the output precision
+  std::vector<char> velocity_;         //!< u, v and 0 at the own nodes, in the output precision
+  std::vector<char> previousP_;        //!< p of the previous frame
+  std::vector<char> previousVelocity_; //!< velocity of the previous frame
+  std::vector<char> difference_;       //!< values XOR the values of the previous frame, of one array
+};
@@ -1,10 +1,11 @@
 #include "output_writer/output_writer_text.h"
 
-void OutputWriterText::writeFile(double currentTime)
+template <typename T>
+void OutputWriterText<T>::writeFile(double currentTime)
 {
   // Assemble the filename
   std::stringstream fileName;
-  fileName << "out/output_" << std::setw(4) << std::setfill('0') << fileNo_ << ".txt";
+  fileName << "out/output_" << std::setw(4) << std::setfill('0') << fileNo_ << fileNameSuffix() << ".txt";
 
   // increment file no.
   fileNo_++;
@@ -174,14 +175,15 @@ void OutputWriterText::writeFile(double currentTime)
   file << std::endl;
 }
 
-void OutputWriterText::writePressureFile()
+template <typename T>
+void OutputWriterText<T>::writePressureFile()
 {
   // counter for files, counter value is part of the file name
   static int pressurefileNo = 0;
 
   // Assemble the filename
   std::stringstream fileName;
-  fileName << "out/pressure_" << std::setw(4) << std::setfill('0') << pressurefileNo++ << ".txt";
+  fileName << "out/pressure_" << std::setw(4) << std::setfill('0') << pressurefileNo++ << fileNameSuffix() << ".txt";
 
   // open file
   std::ofstream file(fileName.str().c_str());
@@ -223,4 +225,14 @@ void OutputWriterText::writePressureFile()
     file << std::endl;
   }
   file << std::endl;
-}
\ No newline at end of file
+}
+
+template <typename T>
+std::string OutputWriterText<T>::fileNameSuffix() const
+{
+  return "";
+}
+
+// scalar types used for the field storage
+template class OutputWriterText<float>;
+template class OutputWriterText<double>;
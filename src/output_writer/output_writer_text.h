@@ -12,14 +12,17 @@
  *
  * All values are written to the file as they are stored in the field variables,
  * no interpolation takes place.
+ *
+ * @tparam T scalar type used to store the field variables
  */
-class OutputWriterText : public OutputWriter
+template <typename T = double>
+class OutputWriterText : public OutputWriter<T>
 {
 public:
   /**
    * @brief Default constructor.
    */
-  using OutputWriter::OutputWriter;
+  using OutputWriter<T>::OutputWriter;
 
   /**
    * @brief Write current velocities to file.
@@ -36,4 +39,13 @@ public:
    * Filename is pressure_<count>.txt
    */
   void writePressureFile();
+
+protected:
+  /**
+   * @brief Part of the filenames between the counter and the extension, empty for a single process
+   */
+  virtual std::string fileNameSuffix() const;
+
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
 };
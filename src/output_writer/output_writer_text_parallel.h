@@ -1,22 +1,31 @@
 #pragma once
 
 #include "output_writer/output_writer_text.h"
-#include "partitioning/partitioning.h"
 
-/** Write *.txt files that are useful for debugging.
- *  All values are written to the file as they are stored in the field variables,
- *  no interpolation takes place.
+/**
+ * @class OutputWriterTextParallel
+ * @brief Write *.txt files that are useful for debugging, one file per rank.
+ *
+ * All values of the own subdomain are written to the file as they are stored in the field variables,
+ * including the ghost layer, no interpolation takes place.
+ * Filenames are output_<count>.<rankNo>.txt and pressure_<count>.<rankNo>.txt.
+ *
+ * @tparam T scalar type used to store the field variables
  */
-class OutputWriterTextParallel : 
-  public OutputWriterText
+template <typename T = double>
+class OutputWriterTextParallel : public OutputWriterText<T>
 {
 public:
-  //! use constructor of base class
-  using OutputWriterText::OutputWriterText;
+  /**
+   * @brief use constructor of base class, the rank is taken from the partitioning of the discretization
+   */
+  using OutputWriterText<T>::OutputWriterText;
 
-  //! write current velocities to file, filename is output_<count>.<rankNo>.txt
-  void writeFile(double currentTime);
+protected:
+  /**
+   * @brief Part of the filenames between the counter and the extension, .<rankNo>
+   */
+  std::string fileNameSuffix() const override;
 
-  //! write only current values of pressure to file, filename is pressure_<count>.<rankNo>.txt
-  void writePressureFile();
+  using OutputWriterText<T>::discretization_;
 };
@@ -0,0 +1,126 @@
+#include "output_writer_vti.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
+#include <mpi.h>
+
+template <typename T>
+OutputWriterVti<T>::OutputWriterVti(std::shared_ptr<StaggeredGrid<T>> discretization, NodeSelection selection,
+                                    VtiFile::Precision precision, BlockCodec codec)
+    : OutputWriter<T>(discretization),
+      selection_(selection),
+      arrays_({{"pressure", 1}, {"velocity", 3}}),
+      precision_(precision),
+      codec_(codec)
+{
+  // ParaView only shows vector glyphs of vectors in ℝ^3, the 3rd component stays zero
+  const int nPointsX = selection_.nPoints()[0];
+  const int valueSize = VtiFile::valueSize(precision_);
+  pressureRow_.resize(valueSize * nPointsX);
+  velocityRow_.resize(3 * valueSize * nPointsX, 0);
+  if (precision_ == VtiFile::Precision::quantized16)
+  {
+    for (int i = 0; i < nPointsX; i++)
+      reinterpret_cast<std::uint16_t *>(velocityRow_.data())[3 * i + 2] = this->quantizedZero;
+  }
+
+  // the extents do not change, rank 0 collects them once for all pvti files, empty extents belong to ranks without piece
+  const Partitioning &partitioning = *discretization_->partitioning();
+  const std::array<int, 4> extent = selection_.extent();
+  std::vector<std::array<int, 4>> extents;
+  if (partitioning.ownRankNo() == 0)
+    extents.resize(partitioning.nRanks());
+  MPI_Gather(extent.data(), 4, MPI_INT, extents.data(), 4, MPI_INT, 0, partitioning.communicator());
+  for (int rankNo = 0; rankNo < int(extents.size()); rankNo++)
+  {
+    if (extents[rankNo][0] <= extents[rankNo][1] && extents[rankNo][2] <= extents[rankNo][3])
+    {
+      pieceExtents_.push_back(extents[rankNo]);
+      pieceRankNos_.push_back(rankNo);
+    }
+  }
+
+  MPI_Comm_split(partitioning.communicator(), selection_.isEmpty() ? MPI_UNDEFINED : 0, partitioning.ownRankNo(), &communicator_);
+}
+
+template <typename T>
+OutputWriterVti<T>::~OutputWriterVti()
+{
+  if (communicator_ != MPI_COMM_NULL)
+    MPI_Comm_free(&communicator_);
+}
+
+template <typename T>
+std::string OutputWriterVti<T>::pieceFileName(int fileNo, int rankNo) const
+{
+  std::stringstream fileName;
+  fileName << "output_" << std::setw(4) << std::setfill('0') << fileNo << "." << rankNo << ".vti";
+  return fileName.str();
+}
+
+template <typename T>
+void OutputWriterVti<T>::writeFile(double currentTime)
+{
+  const int ownRankNo = discretization_->partitioning()->ownRankNo();
+  if (ownRankNo == 0)
+  {
+    std::stringstream fileName;
+    fileName << "out/output_" << std::setw(4) << std::setfill('0') << fileNo_ << ".pvti";
+
+    std::vector<std::string> pieceFileNames;
+    for (int rankNo : pieceRankNos_)
+      pieceFileNames.push_back(pieceFileName(fileNo_, rankNo));
+    VtiFile::writeMasterFile(fileName.str(), selection_.wholeExtent(), selection_.origin(), selection_.spacing(), arrays_,
+                             pieceExtents_, pieceFileNames, precision_);
+  }
+
+  // increment file no.
+  const int fileNo = fileNo_++;
+
+  // ranks without selected nodes do not take part
+  if (selection_.isEmpty())
+    return;
+
+  // the node values lie between the stored values, the largest ones of the ranks bound the quantized values
+  if (precision_ == VtiFile::Precision::quantized16)
+  {
+    std::array<double, 2> absMax = {discretization_->p().findAbsMax(),
+                                    std::max(discretization_->u().findAbsMax(), discretization_->v().findAbsMax())};
+    MPI_Allreduce(MPI_IN_PLACE, absMax.data(), 2, MPI_DOUBLE, MPI_MAX, communicator_);
+    this->setQuantization(arrays_[0], absMax[0]);
+    this->setQuantization(arrays_[1], absMax[1]);
+  }
+
+  VtiFile file("out/" + pieceFileName(fileNo, ownRankNo), selection_.wholeExtent(), selection_.extent(), selection_.origin(),
+               selection_.spacing(), currentTime, arrays_, precision_, codec_);
+  if (!file.isOpen())
+    return;
+
+  // the nodes on the upper edges are interpolated from the ghost layers
+  const std::array<int, 2> nPoints = selection_.nPoints();
+  const int stride = selection_.stride();
+  const int valueSize = VtiFile::valueSize(precision_);
+  file.beginArray();
+  for (int j = 0; j < nPoints[1]; j++)
+  {
+    this->interpolateToNodes(discretization_->p(), selection_.rows(j, j + 1), pressureRow_.data(), 1, precision_, arrays_[0], stride);
+    file.write(pressureRow_.data(), nPoints[0]);
+  }
+
+  file.beginArray();
+  for (int j = 0; j < nPoints[1]; j++)
+  {
+    const IndexRange row = selection_.rows(j, j + 1);
+    this->interpolateToNodes(discretization_->u(), row, &velocityRow_[0], 3, precision_, arrays_[1], stride);
+    this->interpolateToNodes(discretization_->v(), row, &velocityRow_[valueSize], 3, precision_, arrays_[1], stride);
+    file.write(velocityRow_.data(), 3 * nPoints[0]);
+  }
+
+  file.close();
+}
+
+// scalar types used for the field storage
+template class OutputWriterVti<float>;
+template class OutputWriterVti<double>;
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "output_writer.h"
+#include "node_selection.h"
+#include "vti_file.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class OutputWriterVti
+ * @brief Write *.vti pieces of all ranks and a *.pvti file that combines them, without the VTK library.
+ *
+ * The same files as OutputWriterParaviewParallel: every rank writes its own piece output_<count>.<rank>.vti,
+ * the nodes on the edges to the neighbours are contained in both pieces, and rank 0 writes output_<count>.pvti.
+ * The values at the nodes are interpolated row by row with FieldVariable::interpolateToNodes into a buffer
+ * that is streamed into the raw appended data of the file by VtiFile, no data set of the whole piece is built.
+ * The values are interpolated directly into the precision of the output and can be compressed with a BlockCodec.
+ * Quantized values of all pieces use the same offset and scale, the ranks agree on them for every output.
+ *
+ * Only the nodes of a NodeSelection are written, ranks without selected nodes write no piece. With a stride,
+ * the edge between two pieces is only contained in both if it lies on a selected node, otherwise the coarse
+ * cells across the edge are missing in ParaView.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class OutputWriterVti : public OutputWriter<T>
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param discretization shared pointer to the discretization of the own subdomain
+   * @param selection nodes to write, with shared edges
+   * @param precision type of the stored values
+   * @param codec compression of the arrays, by default none
+   */
+  OutputWriterVti(std::shared_ptr<StaggeredGrid<T>> discretization, NodeSelection selection,
+                  VtiFile::Precision precision = VtiFile::Precision::float64, BlockCodec codec = BlockCodec());
+
+  //! free the communicator
+  ~OutputWriterVti();
+
+  /**
+   * @brief Write current velocities and pressure to the own piece, rank 0 also writes the pvti file,
+   *        filename is output_<count>.pvti
+   *
+   * @param currentTime current time in simulation
+   */
+  void writeFile(double currentTime);
+
+private:
+  /**
+   * @brief file name of a piece without directory, relative to the pvti file
+   */
+  std::string pieceFileName(int fileNo, int rankNo) const;
+
+  using OutputWriter<T>::discretization_;
+  using OutputWriter<T>::fileNo_;
+
+  NodeSelection selection_; //!< nodes to write
+
+  std::vector<VtiFile::Array> arrays_;           //!< pressure and velocity
+  VtiFile::Precision precision_;                 //!< type of the stored values
+  BlockCodec codec_;                             //!< compression of the arrays
+  std::vector<std::array<int, 4>> pieceExtents_; //!< on rank 0: extents of the pieces of the ranks with selected nodes
+  std::vector<int> pieceRankNos_;                //!< on rank 0: ranks with selected nodes
+  MPI_Comm communicator_;                        //!< own communicator of the ranks with selected nodes, MPI_COMM_NULL on the others
+
+  std::vector<char> pressureRow_; //!< p at one row of nodes, in the output precision
+  std::vector<char> velocityRow_; //!< u, v and 0 at one row of nodes, in the output precision
+};
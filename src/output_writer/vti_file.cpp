@@ -0,0 +1,296 @@
+#include "vti_file.h"
+
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+  /**
+   * @brief byte order of the machine, the values are written as they are stored
+   */
+  const char *byteOrder()
+  {
+    const int one = 1;
+    return *reinterpret_cast<const char *>(&one) == 1 ? "LittleEndian" : "BigEndian";
+  }
+
+  /**
+   * @brief extent in x and y as XML attribute value, one node in z direction
+   */
+  std::string extentText(std::array<int, 4> extent)
+  {
+    std::stringstream text;
+    text << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3] << " 0 0";
+    return text.str();
+  }
+}
+
+VtiFile::Precision VtiFile::precisionFromName(std::string name)
+{
+  if (name == "float64")
+    return Precision::float64;
+  if (name == "float32")
+    return Precision::float32;
+  if (name == "quantized16")
+    return Precision::quantized16;
+  throw std::invalid_argument("Supported output precisions are float64, float32 and quantized16.");
+}
+
+int VtiFile::valueSize(Precision precision)
+{
+  switch (precision)
+  {
+  case Precision::float32:
+    return sizeof(float);
+  case Precision::quantized16:
+    return sizeof(std::uint16_t);
+  default:
+    return sizeof(double);
+  }
+}
+
+std::string VtiFile::typeName(Precision precision)
+{
+  switch (precision)
+  {
+  case Precision::float32:
+    return "Float32";
+  case Precision::quantized16:
+    return "UInt16";
+  default:
+    return "Float64";
+  }
+}
+
+VtiFile::VtiFile(std::string fileName, std::array<int, 4> wholeExtent, std::array<int, 4> extent,
+                 std::array<double, 2> origin, std::array<double, 2> spacing, double currentTime, std::vector<Array> arrays,
+                 Precision precision,
+                 BlockCodec codec) :
+  file_(std::fopen(fileName.c_str(), "wb")),
+  precision_(precision),
+  codec_(codec),
+  buffer_(bufferSize),
+  bufferUsed_(0),
+  arrays_(arrays),
+  wholeExtent_(wholeExtent),
+  extent_(extent),
+  origin_(origin),
+  spacing_(spacing),
+  currentTime_(currentTime),
+  nPoints_(std::uint64_t(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1)),
+  arrayNo_(-1),
+  bytesLeft_(0)
+{
+  if (file_ == nullptr)
+  {
+    std::cout << "Could not write to file \"" << fileName << "\"." << std::endl;
+    return;
+  }
+
+  // the values are collected in buffer_, the buffer of the C library would only copy them once more
+  std::setvbuf(file_, nullptr, _IONBF, 0);
+
+  // the offsets of compressed arrays are only known after all values are encoded
+  if (codec_.method() != BlockCodec::Method::none)
+  {
+    arrayValues_.resize(arrays_.size());
+    return;
+  }
+
+  const std::string headerText = header(wholeExtent, extent, origin, spacing, currentTime, arrays_, precision_);
+  std::fwrite(headerText.data(), 1, headerText.size(), file_);
+}
+
+VtiFile::~VtiFile()
+{
+  close();
+}
+
+bool VtiFile::isOpen() const
+{
+  return file_ != nullptr;
+}
+
+void VtiFile::beginArray()
+{
+  assert(bytesLeft_ == 0 && arrayNo_ + 1 < int(arrays_.size()));
+  arrayNo_++;
+
+  const std::uint64_t bytes = valueSize(precision_) * nPoints_ * arrays_[arrayNo_].nComponents;
+  bytesLeft_ = bytes;
+
+  if (codec_.method() != BlockCodec::Method::none)
+  {
+    arrayValues_[arrayNo_].reserve(bytes);
+    return;
+  }
+
+  // the size is a value in the appended data like the others
+  if (bufferUsed_ + sizeof(bytes) > buffer_.size())
+    flush();
+  std::memcpy(buffer_.data() + bufferUsed_, &bytes, sizeof(bytes));
+  bufferUsed_ += sizeof(bytes);
+}
+
+void VtiFile::write(const void *values, std::size_t nValues)
+{
+  const std::size_t bytes = valueSize(precision_) * nValues;
+  const char *valueBytes = static_cast<const char *>(values);
+  assert(bytes <= bytesLeft_);
+  bytesLeft_ -= bytes;
+
+  if (codec_.method() != BlockCodec::Method::none)
+  {
+    arrayValues_[arrayNo_].insert(arrayValues_[arrayNo_].end(), valueBytes, valueBytes + bytes);
+    return;
+  }
+
+  if (bufferUsed_ + bytes > buffer_.size())
+    flush();
+
+  // values that do not fit into the buffer are written directly
+  if (bytes > buffer_.size())
+  {
+    if (file_ != nullptr)
+      std::fwrite(values, 1, bytes, file_);
+    return;
+  }
+  std::memcpy(buffer_.data() + bufferUsed_, values, bytes);
+  bufferUsed_ += bytes;
+}
+
+void VtiFile::close()
+{
+  if (file_ == nullptr)
+    return;
+
+  assert(bytesLeft_ == 0 && arrayNo_ + 1 == int(arrays_.size()));
+
+  // encode the arrays, the blocks of an array in parallel, and write them after the header
+  if (codec_.method() != BlockCodec::Method::none)
+  {
+    const int nPointsX = extent_[1] - extent_[0] + 1;
+    std::vector<std::vector<char>> encodedArrays;
+    std::vector<std::uint64_t> encodedSizes;
+    for (std::size_t arrayNo = 0; arrayNo < arrays_.size(); arrayNo++)
+    {
+      const std::vector<char> &values = arrayValues_[arrayNo];
+      const int nComponents = arrays_[arrayNo].nComponents;
+      encodedArrays.push_back(codec_.encode(values.data(), values.size() / valueSize(precision_), valueSize(precision_),
+                                            nComponents, nComponents * nPointsX));
+      encodedSizes.push_back(encodedArrays.back().size());
+    }
+
+    const std::string headerText = header(wholeExtent_, extent_, origin_, spacing_, currentTime_, arrays_, precision_,
+                                          codec_, encodedSizes);
+    std::fwrite(headerText.data(), 1, headerText.size(), file_);
+    for (const std::vector<char> &encoded : encodedArrays)
+      std::fwrite(encoded.data(), 1, encoded.size(), file_);
+  }
+
+  flush();
+  const std::string footerText = footer();
+  std::fwrite(footerText.data(), 1, footerText.size(), file_);
+  std::fclose(file_);
+  file_ = nullptr;
+}
+
+void VtiFile::flush()
+{
+  if (file_ != nullptr && bufferUsed_ > 0)
+    std::fwrite(buffer_.data(), 1, bufferUsed_, file_);
+  bufferUsed_ = 0;
+}
+
+std::string VtiFile::header(std::array<int, 4> wholeExtent, std::array<int, 4> extent, std::array<double, 2> origin,
+                            std::array<double, 2> spacing, double currentTime, const std::vector<Array> &arrays, Precision precision,
+                            const BlockCodec &codec, const std::vector<std::uint64_t> &encodedSizes)
+{
+  const std::uint64_t nPoints = std::uint64_t(extent[1] - extent[0] + 1) * (extent[3] - extent[2] + 1);
+
+  std::stringstream header;
+  header << std::setprecision(17)
+         << "<?xml version=\"1.0\"?>" << std::endl
+         << "<VTKFile type=\"ImageData\" version=\"1.0\" byte_order=\"" << byteOrder() << "\" header_type=\"UInt64\"";
+  const std::string compressor = codec.compressorName();
+  if (!compressor.empty())
+    header << " compressor=\"" << compressor << "\"";
+  if (codec.method() == BlockCodec::Method::lossy)
+    header << " tolerance=\"" << codec.tolerance() << "\"";
+  header << ">" << std::endl
+         << "  <ImageData WholeExtent=\"" << extentText(wholeExtent) << "\""
+         << " Origin=\"" << origin[0] << " " << origin[1] << " 0\" Spacing=\"" << spacing[0] << " " << spacing[1] << " 1\">" << std::endl
+         << "    <FieldData>" << std::endl
+         << "      <DataArray type=\"Float64\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">" << currentTime << "</DataArray>" << std::endl;
+  if (precision == Precision::quantized16)
+  {
+    for (const Array &array : arrays)
+    {
+      header << "      <DataArray type=\"Float64\" Name=\"" << array.name << "_quantization\" NumberOfComponents=\"2\""
+             << " NumberOfTuples=\"1\" format=\"ascii\">" << array.offset << " " << array.scale << "</DataArray>" << std::endl;
+    }
+  }
+  header << "    </FieldData>" << std::endl
+         << "    <Piece Extent=\"" << extentText(extent) << "\">" << std::endl
+         << "      <PointData>" << std::endl;
+
+  // every array is preceded by its size, compressed arrays by the sizes of their blocks
+  std::uint64_t offset = 0;
+  for (std::size_t arrayNo = 0; arrayNo < arrays.size(); arrayNo++)
+  {
+    const Array &array = arrays[arrayNo];
+    header << "        <DataArray type=\"" << typeName(precision) << "\" Name=\"" << array.name << "\" NumberOfComponents=\"" << array.nComponents
+           << "\" format=\"appended\" offset=\"" << offset << "\"/>" << std::endl;
+    if (compressor.empty())
+      offset += sizeof(std::uint64_t) + valueSize(precision) * nPoints * array.nComponents;
+    else
+      offset += encodedSizes[arrayNo];
+  }
+
+  header << "      </PointData>" << std::endl
+         << "    </Piece>" << std::endl
+         << "  </ImageData>" << std::endl
+         << "  <AppendedData encoding=\"raw\">" << std::endl
+         << "   _";
+  return header.str();
+}
+
+std::string VtiFile::footer()
+{
+  return "\n  </AppendedData>\n</VTKFile>\n";
+}
+
+void VtiFile::writeMasterFile(std::string fileName, std::array<int, 4> wholeExtent, std::array<double, 2> origin,
+                              std::array<double, 2> spacing,
+                              const std::vector<Array> &arrays, const std::vector<std::array<int, 4>> &pieceExtents,
+                              const std::vector<std::string> &pieceFileNames, Precision precision)
+{
+  std::ofstream file(fileName.c_str(), std::ios::out);
+  if (!file.is_open())
+  {
+    std::cout << "Could not write to file \"" << fileName << "\"." << std::endl;
+    return;
+  }
+
+  file << "<?xml version=\"1.0\"?>" << std::endl
+       << "<VTKFile type=\"PImageData\" version=\"0.1\" byte_order=\"" << byteOrder() << "\">" << std::endl
+       << "  <PImageData WholeExtent=\"" << extentText(wholeExtent) << "\" GhostLevel=\"0\""
+       << std::setprecision(17) << " Origin=\"" << origin[0] << " " << origin[1] << " 0\""
+       << " Spacing=\"" << spacing[0] << " " << spacing[1] << " 1\">" << std::endl
+       << "    <PPointData>" << std::endl;
+  for (const Array &array : arrays)
+    file << "      <PDataArray type=\"" << typeName(precision) << "\" Name=\"" << array.name << "\" NumberOfComponents=\"" << array.nComponents << "\"/>" << std::endl;
+  file << "    </PPointData>" << std::endl;
+  for (std::size_t pieceNo = 0; pieceNo < pieceExtents.size(); pieceNo++)
+  {
+    file << "    <Piece Extent=\"" << extentText(pieceExtents[pieceNo]) << "\""
+         << " Source=\"" << pieceFileNames[pieceNo] << "\"/>" << std::endl;
+  }
+  file << "  </PImageData>" << std::endl
+       << "</VTKFile>" << std::endl;
+}
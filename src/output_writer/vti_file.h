@@ -0,0 +1,164 @@
+#pragma once
+
+#include "block_codec.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @class VtiFile
+ * @brief Stream a vtk image data file (*.vti) without the VTK library, can be viewed with ParaView.
+ *
+ * The XML header that describes the mesh and the arrays is written by the constructor, the values
+ * follow in a raw appended section. Every array is started with beginArray, which writes its size,
+ * and its values are then appended with write in pieces of any size, e.g. row by row, in the order
+ * of the nodes. The values are collected in a large buffer that is written with few system calls.
+ * The file format is the one of vtkXMLImageDataWriter, version 1.0 with 64 bit array sizes.
+ *
+ * The values are stored in the Precision of the file: Float64, Float32 or quantized to UInt16 with an offset
+ * and a scale per array, value = offset + scale * stored, which are given as field data <name>_quantization.
+ *
+ * With a compressing BlockCodec, the arrays are collected in memory instead, because the offsets
+ * in the header depend on the compressed sizes, and are encoded and written by close.
+ */
+class VtiFile
+{
+public:
+  //! type of the stored values
+  enum class Precision
+  {
+    float64,
+    float32,
+    quantized16
+  };
+
+  /**
+   * @struct Array
+   * @brief name and number of components of a point data array
+   */
+  struct Array
+  {
+    std::string name;    //!< name of the array in ParaView
+    int nComponents;     //!< number of values per node
+    double offset = 0.0; //!< quantized16: value that is stored as 0
+    double scale = 1.0;  //!< quantized16: difference of the values that are stored as 0 and 1
+  };
+
+  /**
+   * @brief precision given by its name in the settings: float64, float32 or quantized16
+   */
+  static Precision precisionFromName(std::string name);
+
+  //! size of a stored value in bytes
+  static int valueSize(Precision precision);
+
+  //! type attribute of the arrays
+  static std::string typeName(Precision precision);
+
+  /**
+   * @brief Open the file and write the header, with compression the header is written by close.
+   *
+   * @param fileName name of the file
+   * @param wholeExtent first and last node index of the whole mesh in x and y direction
+   * @param extent first and last node index of the nodes in this file, a piece of the whole mesh
+   * @param origin position of the node with index (0,0)
+   * @param spacing distance of the nodes in x and y direction
+   * @param currentTime current time in simulation, stored as field data TIME
+   * @param arrays point data arrays, in the order in which they are written
+   * @param precision type of the stored values
+   * @param codec compression of the arrays, by default none
+   */
+  VtiFile(std::string fileName, std::array<int, 4> wholeExtent, std::array<int, 4> extent,
+          std::array<double, 2> origin, std::array<double, 2> spacing, double currentTime, std::vector<Array> arrays,
+          Precision precision = Precision::float64, BlockCodec codec = BlockCodec());
+
+  //! write the rest of the buffer and close the file
+  ~VtiFile();
+
+  //! the file is written through the buffer, it cannot be copied
+  VtiFile(const VtiFile &) = delete;
+  VtiFile &operator=(const VtiFile &) = delete;
+
+  /**
+   * @brief if the file could be opened, otherwise all writes are ignored
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief start the next array, all values of the previous one have to be written
+   */
+  void beginArray();
+
+  /**
+   * @brief append values of the current array
+   *
+   * @param values pointer to the first value, of the type of the precision of the file: double, float or std::uint16_t
+   * @param nValues number of values, nodes times components
+   */
+  void write(const void *values, std::size_t nValues);
+
+  /**
+   * @brief write the footer and close the file, all arrays have to be written
+   */
+  void close();
+
+  /**
+   * @brief XML header up to the start of the appended data, the arrays of the piece follow each other,
+   *        each preceded by its size as UInt64, or each encoded with the compressor
+   *
+   * @param precision type of the stored values
+   * @param codec compression of the arrays, its name and the tolerance of the lossy method are attributes of the file
+   * @param encodedSizes size of every encoded array in the appended data, only for compressed arrays
+   */
+  static std::string header(std::array<int, 4> wholeExtent, std::array<int, 4> extent, std::array<double, 2> origin,
+                            std::array<double, 2> spacing, double currentTime, const std::vector<Array> &arrays, Precision precision = Precision::float64,
+                            const BlockCodec &codec = BlockCodec(), const std::vector<std::uint64_t> &encodedSizes = {});
+
+  /**
+   * @brief end of the file after the appended data
+   */
+  static std::string footer();
+
+  /**
+   * @brief Write a *.pvti file that combines the *.vti pieces of all ranks.
+   *
+   * @param fileName name of the pvti file
+   * @param wholeExtent first and last node index of the whole mesh in x and y direction
+   * @param origin position of the node with index (0,0)
+   * @param spacing distance of the nodes in x and y direction
+   * @param arrays point data arrays of the pieces
+   * @param pieceExtents extents of the pieces
+   * @param pieceFileNames file names of the pieces, relative to the pvti file
+   * @param precision type of the values in the pieces
+   */
+  static void writeMasterFile(std::string fileName, std::array<int, 4> wholeExtent, std::array<double, 2> origin,
+                              std::array<double, 2> spacing,
+                              const std::vector<Array> &arrays, const std::vector<std::array<int, 4>> &pieceExtents,
+                              const std::vector<std::string> &pieceFileNames, Precision precision = Precision::float64);
+
+private:
+  //! write the buffer to the file
+  void flush();
+
+  static constexpr std::size_t bufferSize = 1 << 20; //!< size of the buffer in bytes
+
+  std::FILE *file_;                              //!< the open file, nullptr if it could not be opened or is closed
+  Precision precision_;                          //!< type of the stored values
+  BlockCodec codec_;                             //!< compression of the arrays
+  std::vector<std::vector<char>> arrayValues_;   //!< with compression: bytes of the arrays, encoded by close
+  std::vector<char> buffer_;                     //!< values that have not been written to the file yet
+  std::size_t bufferUsed_;                       //!< number of bytes in buffer_
+  std::vector<Array> arrays_;                    //!< point data arrays in the order in which they are written
+  std::array<int, 4> wholeExtent_;               //!< first and last node index of the whole mesh
+  std::array<int, 4> extent_;                    //!< first and last node index of the nodes in this file
+  std::array<double, 2> origin_;                 //!< position of the node with index (0,0)
+  std::array<double, 2> spacing_;                //!< distance of the nodes
+  double currentTime_;                           //!< time stored in the file
+  std::uint64_t nPoints_;                        //!< number of nodes in the file
+  int arrayNo_;                                  //!< index of the current array, -1 before the first
+  std::uint64_t bytesLeft_;                      //!< bytes of the current array that are still to be written
+};
@@ -0,0 +1,221 @@
+#include "halo_exchange.h"
+
+#include <algorithm>
+#include <cassert>
+
+template <>
+MPI_Datatype mpiDatatype<float>()
+{
+  return MPI_FLOAT;
+}
+
+template <>
+MPI_Datatype mpiDatatype<double>()
+{
+  return MPI_DOUBLE;
+}
+
+template <typename T>
+const std::array<std::array<int, 2>, 8> HaloExchange<T>::directions_ = {{
+  {-1, 0}, {1, 0}, {0, -1}, {0, 1},     // left, right, bottom, top
+  {-1, -1}, {1, -1}, {-1, 1}, {1, 1}    // bottom left, bottom right, top left, top right
+}};
+
+//! index of the direction that points the other way, the neighbour sends in this direction to us
+static int oppositeDirection(int direction)
+{
+  // the faces and the corners are stored in pairs of opposite directions
+  return direction < 4 ? direction ^ 1 : direction ^ 3;
+}
+
+template <typename T>
+HaloExchange<T>::HaloExchange(std::shared_ptr<Partitioning> partitioning, bool corners, int ghostWidth) :
+  partitioning_(partitioning),
+  nCells_(partitioning->nCellsLocal()),
+  ghostWidth_(ghostWidth),
+  hasNeighbours_(false),
+  communicator_(MPI_COMM_NULL)
+{
+  assert(ghostWidth >= 1);
+  for (int direction = 0; direction < 8; direction++)
+  {
+    const bool isCorner = direction >= 4;
+    neighbourRankNo_[direction] = isCorner && !corners ? MPI_PROC_NULL : partitioning_->neighbourRankNo(directions_[direction]);
+    hasNeighbours_ = hasNeighbours_ || neighbourRankNo_[direction] != MPI_PROC_NULL;
+  }
+  sendDatatypes_.fill(MPI_DATATYPE_NULL);
+  receiveDatatypes_.fill(MPI_DATATYPE_NULL);
+
+  // a single subdomain does not communicate, no MPI calls at all
+  if (!hasNeighbours_)
+    return;
+
+  MPI_Comm_dup(partitioning_->communicator(), &communicator_);
+
+  // all field variables have the same shape, the datatypes are shared by all of them
+  for (int direction = 0; direction < 8; direction++)
+  {
+    if (neighbourRankNo_[direction] == MPI_PROC_NULL)
+      continue;
+
+    sendDatatypes_[direction] = regionDatatype(region(direction, false));
+    receiveDatatypes_[direction] = regionDatatype(region(direction, true));
+  }
+}
+
+template <typename T>
+HaloExchange<T>::~HaloExchange()
+{
+  if (!hasNeighbours_)
+    return;
+
+  for (Transfer &transfer : transfers_)
+  {
+    for (MPI_Request &request : transfer.requests)
+      MPI_Request_free(&request);
+  }
+  for (int direction = 0; direction < 8; direction++)
+  {
+    if (sendDatatypes_[direction] != MPI_DATATYPE_NULL)
+      MPI_Type_free(&sendDatatypes_[direction]);
+    if (receiveDatatypes_[direction] != MPI_DATATYPE_NULL)
+      MPI_Type_free(&receiveDatatypes_[direction]);
+  }
+  MPI_Comm_free(&communicator_);
+}
+
+template <typename T>
+IndexRange HaloExchange<T>::region(int direction, bool ghost) const
+{
+  const std::array<int, 2> offset = directions_[direction];
+  std::array<int, 2> begin;
+  std::array<int, 2> end;
+  for (int dimension = 0; dimension < 2; dimension++)
+  {
+    const int n = nCells_[dimension];
+    if (offset[dimension] < 0)
+    {
+      // the bands next to the lower neighbour
+      begin[dimension] = ghost ? 0 : ghostWidth_;
+    }
+    else if (offset[dimension] > 0)
+    {
+      // the bands next to the upper neighbour
+      begin[dimension] = ghost ? n + ghostWidth_ : n;
+    }
+    else
+    {
+      // a face runs along this dimension, into the ghost layer on the sides without a neighbour,
+      // the corners next to a neighbour come from the diagonal neighbour
+      const bool lowerNeighbour = neighbourRankNo_[2 * dimension] != MPI_PROC_NULL;
+      const bool upperNeighbour = neighbourRankNo_[2 * dimension + 1] != MPI_PROC_NULL;
+      begin[dimension] = lowerNeighbour ? ghostWidth_ : 0;
+      end[dimension] = upperNeighbour ? n + ghostWidth_ : n + 2 * ghostWidth_;
+      continue;
+    }
+    end[dimension] = begin[dimension] + ghostWidth_;
+  }
+  return {begin[0], end[0], begin[1], end[1]};
+}
+
+template <typename T>
+MPI_Datatype HaloExchange<T>::regionDatatype(const IndexRange &region) const
+{
+  const DefaultLayout layout({nCells_[0] + 2 * ghostWidth_, nCells_[1] + 2 * ghostWidth_});
+  const int width = region.iEnd - region.iBegin;
+  const int height = region.jEnd - region.jBegin;
+  const int first = layout.index(region.iBegin, region.jBegin);
+  const int stride = height > 1 ? layout.index(region.iBegin, region.jBegin + 1) - first : width;
+
+  // position of the entries relative to the first one, row by row
+  std::vector<int> displacements;
+  bool isVector = true;
+  for (int j = region.jBegin; j < region.jEnd; j++)
+  {
+    for (int i = region.iBegin; i < region.iEnd; i++)
+    {
+      displacements.push_back(layout.index(i, j) - first);
+      isVector = isVector && displacements.back() == (j - region.jBegin) * stride + (i - region.iBegin);
+    }
+  }
+
+  // contiguous rows with a constant stride, i.e. all regions of the row-major layout, are a vector,
+  // the blocked layouts need the position of every entry
+  MPI_Datatype datatype;
+  if (isVector)
+    MPI_Type_vector(height, width, stride, mpiDatatype<T>(), &datatype);
+  else
+    MPI_Type_create_indexed_block(displacements.size(), 1, displacements.data(), mpiDatatype<T>(), &datatype);
+  MPI_Type_commit(&datatype);
+  return datatype;
+}
+
+template <typename T>
+void HaloExchange<T>::exchange(FieldVariable<T> &field)
+{
+  begin(field);
+  finish();
+}
+
+template <typename T>
+void HaloExchange<T>::begin(FieldVariable<T> &field)
+{
+  assert(field.size()[0] == nCells_[0] + 2 * ghostWidth_ && field.size()[1] == nCells_[1] + 2 * ghostWidth_);
+  if (!hasNeighbours_)
+    return;
+
+  auto isField = [&](const Transfer &transfer)
+  {
+    return transfer.field == &field;
+  };
+  int index = std::find_if(transfers_.begin(), transfers_.end(), isField) - transfers_.begin();
+
+  // the first exchange of a field variable creates its persistent requests, the messages
+  // of different field variables are told apart by their tag
+  if (index == int(transfers_.size()))
+  {
+    Transfer transfer = {&field, {}};
+    const int tag = 8 * index;
+    for (int direction = 0; direction < 8; direction++)
+    {
+      if (neighbourRankNo_[direction] == MPI_PROC_NULL)
+        continue;
+
+      const IndexRange ghost = region(direction, true);
+      transfer.requests.emplace_back();
+      MPI_Recv_init(&field(ghost.iBegin, ghost.jBegin), 1, receiveDatatypes_[direction], neighbourRankNo_[direction],
+                    tag + oppositeDirection(direction), communicator_, &transfer.requests.back());
+    }
+    for (int direction = 0; direction < 8; direction++)
+    {
+      if (neighbourRankNo_[direction] == MPI_PROC_NULL)
+        continue;
+
+      const IndexRange own = region(direction, false);
+      transfer.requests.emplace_back();
+      MPI_Send_init(&field(own.iBegin, own.jBegin), 1, sendDatatypes_[direction], neighbourRankNo_[direction],
+                    tag + direction, communicator_, &transfer.requests.back());
+    }
+    transfers_.push_back(transfer);
+  }
+
+  std::vector<MPI_Request> &requests = transfers_[index].requests;
+  MPI_Startall(requests.size(), requests.data());
+  pending_.push_back(index);
+}
+
+template <typename T>
+void HaloExchange<T>::finish()
+{
+  // the ghost values are received in place
+  for (int index : pending_)
+  {
+    std::vector<MPI_Request> &requests = transfers_[index].requests;
+    MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+  }
+  pending_.clear();
+}
+
+// scalar types used for the field storage
+template class HaloExchange<float>;
+template class HaloExchange<double>;
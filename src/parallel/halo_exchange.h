@@ -0,0 +1,127 @@
+#pragma once
+
+#include "partitioning.h"
+#include "storage/field_variable.h"
+#include "storage/iteration.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <mpi.h>
+
+/**
+ * @class HaloExchange
+ * @brief Exchanges the ghost layer of field variables with the neighbouring subdomains.
+ *
+ * All field variables of a subdomain have nCellsLocal + 2 * ghostWidth entries per direction. The first and
+ * last ghostWidth own columns/rows are sent to the left/right resp. bottom/top neighbour and stored in its
+ * ghost layer. The corner blocks of subdomains with a diagonal neighbour are exchanged with it directly.
+ * At the boundary of the domain the columns and rows are extended into the ghost layer of the sender, so the
+ * boundary values next to a neighbour are passed on. Every ghost value is received from exactly one neighbour,
+ * therefore all messages of a field variable can be in flight at the same time.
+ * Ghost values on the boundary of the domain are left untouched, they are set by the boundary conditions.
+ *
+ * The messages are sent from and received into the storage of the field variable without copies.
+ * The bands of columns and rows are described by MPI datatypes that are created once for the shape of the field
+ * variables, every field variable gets persistent requests the first time it is exchanged.
+ *
+ * An exchange is split in begin and finish, the own cells away from the sent columns and rows
+ * can be computed in between, while the messages are in flight.
+ *
+ * @tparam T scalar type used to store the field variables
+ */
+template <typename T = double>
+class HaloExchange
+{
+public:
+  /**
+   * @brief Constructor.
+   *
+   * @param partitioning subdomains and neighbour ranks
+   * @param corners if the corner values are exchanged with the diagonal neighbours,
+   *                only needed by stencils that read diagonal cells like the convection terms
+   * @param ghostWidth number of ghost layers of the exchanged field variables
+   */
+  HaloExchange(std::shared_ptr<Partitioning> partitioning, bool corners = true, int ghostWidth = 1);
+
+  //! free the persistent requests, the datatypes and the communicator
+  ~HaloExchange();
+
+  //! the persistent requests refer to the field variables, the exchange cannot be copied
+  HaloExchange(const HaloExchange &) = delete;
+  HaloExchange &operator=(const HaloExchange &) = delete;
+
+  /**
+   * @brief exchange the ghost layer of a field variable, blocking
+   *
+   * @param field field variable with nCellsLocal + 2 * ghostWidth entries per direction
+   */
+  void exchange(FieldVariable<T> &field);
+
+  /**
+   * @brief start the messages for the ghost layer of a field variable and return without waiting
+   *
+   * The first and last ghostWidth own columns and rows must not be changed and the ghost layer
+   * must not be accessed until finish has returned.
+   *
+   * @param field field variable with nCellsLocal + 2 * ghostWidth entries per direction
+   */
+  void begin(FieldVariable<T> &field);
+
+  /**
+   * @brief wait for the messages of all begun exchanges, afterwards the ghost layers are up to date
+   */
+  void finish();
+
+private:
+  /**
+   * @struct Transfer
+   * @brief persistent requests of one field variable
+   */
+  struct Transfer
+  {
+    FieldVariable<T> *field;           //!< field variable whose ghost layer is exchanged
+    std::vector<MPI_Request> requests; //!< persistent sends and receives, one of each per neighbour
+  };
+
+  /**
+   * @brief own cells that are sent to the neighbour in a direction or ghost cells that are received from it
+   *
+   * Bands of columns and rows reach into the ghost layer on the sides without a neighbour,
+   * the corners are blocks of ghostWidth x ghostWidth cells.
+   *
+   * @param direction index in directions_
+   * @param ghost true for the ghost cells, false for the own cells next to them
+   */
+  IndexRange region(int direction, bool ghost) const;
+
+  /**
+   * @brief datatype that selects the entries of a region relative to its first entry in the storage of a field variable
+   */
+  MPI_Datatype regionDatatype(const IndexRange &region) const;
+
+  static const std::array<std::array<int, 2>, 8> directions_; //!< offsets of the neighbours, faces first, then corners
+
+  std::shared_ptr<Partitioning> partitioning_;     //!< subdomains and neighbour ranks
+  std::array<int, 2> nCells_;                      //!< number of own cells in x and y direction
+  int ghostWidth_;                                 //!< number of ghost layers
+  std::array<int, 8> neighbourRankNo_;             //!< rank of the neighbour in each direction or MPI_PROC_NULL
+  bool hasNeighbours_;                             //!< false for a single subdomain, no messages at all
+  MPI_Comm communicator_;                          //!< own copy of the communicator, the tags are not shared
+  std::array<MPI_Datatype, 8> sendDatatypes_;      //!< own regions, one per direction with a neighbour
+  std::array<MPI_Datatype, 8> receiveDatatypes_;   //!< ghost regions, one per direction with a neighbour
+  std::vector<Transfer> transfers_;                //!< persistent requests of the field variables exchanged so far
+  std::vector<int> pending_;                       //!< indices in transfers_ of the exchanges begun and not finished
+};
+
+/**
+ * @brief MPI datatype of a scalar type, MPI_FLOAT or MPI_DOUBLE
+ */
+template <typename T>
+MPI_Datatype mpiDatatype();
+
+template <>
+MPI_Datatype mpiDatatype<float>();
+
+template <>
+MPI_Datatype mpiDatatype<double>();
@@ -0,0 +1,196 @@
+#include "partitioning.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+Partitioning::Partitioning(std::array<int,2> nCellsGlobal) :
+  nCellsGlobal_(nCellsGlobal),
+  nCellsLocal_(nCellsGlobal),
+  nSubdomains_{1,1},
+  coordinates_{0,0},
+  nodeOffset_{0,0},
+  ownRankNo_(0),
+  nRanks_(1),
+  leftNeighbourRankNo_(MPI_PROC_NULL),
+  rightNeighbourRankNo_(MPI_PROC_NULL),
+  bottomNeighbourRankNo_(MPI_PROC_NULL),
+  topNeighbourRankNo_(MPI_PROC_NULL),
+  communicator_(MPI_COMM_SELF)
+{
+}
+
+Partitioning::~Partitioning()
+{
+  // the communicator of a single process is not created by the partitioning
+  int isFinalized = 0;
+  MPI_Finalized(&isFinalized);
+  if (communicator_ != MPI_COMM_SELF && !isFinalized)
+    MPI_Comm_free(&communicator_);
+}
+
+void Partitioning::initialize(std::array<int,2> nCellsGlobal)
+{
+  nCellsGlobal_ = nCellsGlobal;
+  MPI_Comm_size(MPI_COMM_WORLD, &nRanks_);
+
+  // balanced factorization proposed by MPI, then the one with the shortest interfaces for this domain
+  std::array<int,2> proposal = {0,0};
+  MPI_Dims_create(nRanks_, 2, proposal.data());
+  nSubdomains_ = chooseProcessGrid(nRanks_, nCellsGlobal_, proposal);
+
+  // non-periodic Cartesian topology, keep the rank numbers of MPI_COMM_WORLD
+  const std::array<int,2> periods = {0,0};
+  MPI_Cart_create(MPI_COMM_WORLD, 2, nSubdomains_.data(), periods.data(), false, &communicator_);
+  MPI_Comm_rank(communicator_, &ownRankNo_);
+  MPI_Cart_coords(communicator_, ownRankNo_, 2, coordinates_.data());
+
+  // neighbours are MPI_PROC_NULL at the boundary of the domain
+  MPI_Cart_shift(communicator_, 0, 1, &leftNeighbourRankNo_, &rightNeighbourRankNo_);
+  MPI_Cart_shift(communicator_, 1, 1, &bottomNeighbourRankNo_, &topNeighbourRankNo_);
+
+  for (int dimension = 0; dimension < 2; dimension++)
+  {
+    nCellsLocal_[dimension] = nCellsOfSubdomain(nCellsGlobal_[dimension], nSubdomains_[dimension], coordinates_[dimension]);
+    nodeOffset_[dimension] = offsetOfSubdomain(nCellsGlobal_[dimension], nSubdomains_[dimension], coordinates_[dimension]);
+  }
+}
+
+std::array<int,2> Partitioning::chooseProcessGrid(int nRanks, std::array<int,2> nCellsGlobal, std::array<int,2> proposal)
+{
+  assert(nRanks > 0);
+
+  // every interface between two columns of subdomains has length nCellsGlobal[1] and vice versa
+  auto interfaceLength = [&](std::array<int,2> grid)
+  {
+    return long(grid[0] - 1) * nCellsGlobal[1] + long(grid[1] - 1) * nCellsGlobal[0];
+  };
+  // every subdomain has to contain at least one cell
+  auto isFeasible = [&](std::array<int,2> grid)
+  {
+    return grid[0] > 0 && grid[1] > 0 && grid[0] <= nCellsGlobal[0] && grid[1] <= nCellsGlobal[1];
+  };
+
+  std::array<int,2> best = proposal;
+  for (int nx = 1; nx <= nRanks; nx++)
+  {
+    if (nRanks % nx != 0)
+      continue;
+
+    const std::array<int,2> grid = {nx, nRanks / nx};
+    if (!isFeasible(grid))
+      continue;
+
+    if (!isFeasible(best) || interfaceLength(grid) < interfaceLength(best))
+      best = grid;
+  }
+
+  if (!isFeasible(best))
+    throw std::invalid_argument("The domain of " + std::to_string(nCellsGlobal[0]) + " x " + std::to_string(nCellsGlobal[1]) +
+                                " cells cannot be split into " + std::to_string(nRanks) +
+                                " subdomains of at least one cell, there are more ranks than cells.");
+  return best;
+}
+
+int Partitioning::nCellsOfSubdomain(int nCells, int nSubdomains, int coordinate)
+{
+  return nCells / nSubdomains + (coordinate < nCells % nSubdomains ? 1 : 0);
+}
+
+int Partitioning::offsetOfSubdomain(int nCells, int nSubdomains, int coordinate)
+{
+  return coordinate * (nCells / nSubdomains) + std::min(coordinate, nCells % nSubdomains);
+}
+
+std::array<int,2> Partitioning::nCellsLocal() const
+{
+  return nCellsLocal_;
+}
+
+std::array<int,2> Partitioning::nCellsGlobal() const
+{
+  return nCellsGlobal_;
+}
+
+int Partitioning::ownRankNo() const
+{
+  return ownRankNo_;
+}
+
+int Partitioning::nRanks() const
+{
+  return nRanks_;
+}
+
+std::array<int,2> Partitioning::nSubdomains() const
+{
+  return nSubdomains_;
+}
+
+MPI_Comm Partitioning::communicator() const
+{
+  return communicator_;
+}
+
+bool Partitioning::ownPartitionContainsBottomBoundary() const
+{
+  return coordinates_[1] == 0;
+}
+
+bool Partitioning::ownPartitionContainsTopBoundary() const
+{
+  return coordinates_[1] == nSubdomains_[1] - 1;
+}
+
+bool Partitioning::ownPartitionContainsLeftBoundary() const
+{
+  return coordinates_[0] == 0;
+}
+
+bool Partitioning::ownPartitionContainsRightBoundary() const
+{
+  return coordinates_[0] == nSubdomains_[0] - 1;
+}
+
+int Partitioning::leftNeighbourRankNo() const
+{
+  return leftNeighbourRankNo_;
+}
+
+int Partitioning::rightNeighbourRankNo() const
+{
+  return rightNeighbourRankNo_;
+}
+
+int Partitioning::topNeighbourRankNo() const
+{
+  return topNeighbourRankNo_;
+}
+
+int Partitioning::bottomNeighbourRankNo() const
+{
+  return bottomNeighbourRankNo_;
+}
+
+int Partitioning::neighbourRankNo(std::array<int,2> offset) const
+{
+  if (offset[0] == 0 && offset[1] == 0)
+    return ownRankNo_;
+
+  std::array<int,2> coordinates = {coordinates_[0] + offset[0], coordinates_[1] + offset[1]};
+  for (int dimension = 0; dimension < 2; dimension++)
+  {
+    if (coordinates[dimension] < 0 || coordinates[dimension] >= nSubdomains_[dimension])
+      return MPI_PROC_NULL;
+  }
+
+  int rankNo = MPI_PROC_NULL;
+  MPI_Cart_rank(communicator_, coordinates.data(), &rankNo);
+  return rankNo;
+}
+
+std::array<int,2> Partitioning::nodeOffset() const
+{
+  return nodeOffset_;
+}
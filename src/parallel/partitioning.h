@@ -1,11 +1,27 @@
 #pragma once
 
 #include <array>
+#include <mpi.h>
 
+/** Decomposition of the computational domain into a 2D Cartesian grid of subdomains, one per MPI rank.
+ *  The process grid is chosen such that the total length of the interfaces between the subdomains,
+ *  i.e. the amount of halo data to exchange, is minimal. Cells that do not divide evenly
+ *  are spread over the first subdomains in each direction, such that the local sizes differ by at most one.
+ */
 class Partitioning
 {
 public:
 
+  //! partitioning of a single process that owns the whole domain, no MPI calls are made
+  Partitioning(std::array<int,2> nCellsGlobal = {0,0});
+
+  //! free the Cartesian communicator
+  ~Partitioning();
+
+  //! the partitioning owns its communicator, it is shared instead of copied
+  Partitioning(const Partitioning &) = delete;
+  Partitioning &operator=(const Partitioning &) = delete;
+
   //! compute partitioning, set internal variables
   void initialize(std::array<int,2> nCellsGlobal);
 
@@ -23,6 +39,12 @@ public:
   //! number of MPI ranks
   int nRanks() const;
 
+  //! number of subdomains in x and y direction
+  std::array<int,2> nSubdomains() const;
+
+  //! communicator with the Cartesian topology of the subdomains
+  MPI_Comm communicator() const;
+
   //! if the own partition has part of the bottom boundary of the whole domain
   bool ownPartitionContainsBottomBoundary() const;
 
@@ -37,20 +59,50 @@ public:
   //! used in OutputWriterParaviewParallel
   bool ownPartitionContainsRightBoundary() const;
 
-  //! get the rank no of the left neighbouring rank
+  //! get the rank no of the left neighbouring rank, MPI_PROC_NULL at the boundary
   int leftNeighbourRankNo() const;
 
-  //! get the rank no of the right neighbouring rank
+  //! get the rank no of the right neighbouring rank, MPI_PROC_NULL at the boundary
   int rightNeighbourRankNo() const;
 
-  //! get the rank no of the top neighbouring rank
+  //! get the rank no of the top neighbouring rank, MPI_PROC_NULL at the boundary
   int topNeighbourRankNo() const;
 
-  //! get the rank no of the bottom neighbouring rank
+  //! get the rank no of the bottom neighbouring rank, MPI_PROC_NULL at the boundary
   int bottomNeighbourRankNo() const;
 
-  //! get the offset values for counting local nodes in x and y direction. 
+  //! get the rank no of the subdomain at the given offset in the process grid, e.g. {1,-1} for the bottom right one,
+  //! MPI_PROC_NULL outside the domain
+  int neighbourRankNo(std::array<int,2> offset) const;
+
+  //! get the offset values for counting local nodes in x and y direction.
   //! (i_local,j_local) + nodeOffset = (i_global,j_global)
   //! used in OutputWriterParaviewParallel
   std::array<int,2> nodeOffset() const;
+
+  //! number of subdomains in x and y direction that minimizes the total interface length,
+  //! ties are resolved in favour of the grid proposed by MPI_Dims_create,
+  //! throws std::invalid_argument if no grid gives every subdomain at least one cell
+  static std::array<int,2> chooseProcessGrid(int nRanks, std::array<int,2> nCellsGlobal, std::array<int,2> proposal = {0,0});
+
+  //! number of cells of subdomain no. coordinate if nCells cells are split evenly into nSubdomains subdomains
+  static int nCellsOfSubdomain(int nCells, int nSubdomains, int coordinate);
+
+  //! index of the first cell of subdomain no. coordinate if nCells cells are split evenly into nSubdomains subdomains
+  static int offsetOfSubdomain(int nCells, int nSubdomains, int coordinate);
+
+private:
+
+  std::array<int,2> nCellsGlobal_;    //!< number of cells in the whole domain
+  std::array<int,2> nCellsLocal_;     //!< number of cells in the own subdomain
+  std::array<int,2> nSubdomains_;     //!< number of subdomains in x and y direction
+  std::array<int,2> coordinates_;     //!< position of the own subdomain in the process grid
+  std::array<int,2> nodeOffset_;      //!< number of cells left of and below the own subdomain
+  int ownRankNo_;                     //!< own rank in communicator_
+  int nRanks_;                        //!< number of ranks
+  int leftNeighbourRankNo_;           //!< rank of the left neighbour or MPI_PROC_NULL
+  int rightNeighbourRankNo_;          //!< rank of the right neighbour or MPI_PROC_NULL
+  int bottomNeighbourRankNo_;         //!< rank of the bottom neighbour or MPI_PROC_NULL
+  int topNeighbourRankNo_;            //!< rank of the top neighbour or MPI_PROC_NULL
+  MPI_Comm communicator_;             //!< Cartesian communicator
 };
@@ -0,0 +1,95 @@
+#include "reduction_batch.h"
+
+#include <algorithm>
+#include <cassert>
+
+ReductionBatch::ReductionBatch(std::shared_ptr<Partitioning> partitioning) :
+  partitioning_(partitioning),
+  entryDatatype_(MPI_DATATYPE_NULL),
+  operation_(MPI_OP_NULL),
+  request_(MPI_REQUEST_NULL)
+{
+  // a single rank does not communicate, no MPI calls at all
+  if (partitioning_->nRanks() == 1)
+    return;
+
+  MPI_Type_contiguous(2, MPI_DOUBLE, &entryDatatype_);
+  MPI_Type_commit(&entryDatatype_);
+  MPI_Op_create(&ReductionBatch::combine, true, &operation_);
+}
+
+ReductionBatch::~ReductionBatch()
+{
+  if (partitioning_->nRanks() == 1)
+    return;
+
+  if (request_ != MPI_REQUEST_NULL)
+    MPI_Wait(&request_, MPI_STATUS_IGNORE);
+  MPI_Op_free(&operation_);
+  MPI_Type_free(&entryDatatype_);
+}
+
+void ReductionBatch::clear()
+{
+  assert(request_ == MPI_REQUEST_NULL);
+  entries_.clear();
+}
+
+int ReductionBatch::add(double value, Operation operation)
+{
+  assert(request_ == MPI_REQUEST_NULL);
+  entries_.push_back({value, double(operation)});
+  return entries_.size() - 1;
+}
+
+void ReductionBatch::reduce()
+{
+  if (partitioning_->nRanks() == 1)
+    return;
+
+  MPI_Allreduce(MPI_IN_PLACE, entries_.data(), entries_.size(), entryDatatype_, operation_, partitioning_->communicator());
+}
+
+void ReductionBatch::begin()
+{
+  if (partitioning_->nRanks() == 1)
+    return;
+
+  MPI_Iallreduce(MPI_IN_PLACE, entries_.data(), entries_.size(), entryDatatype_, operation_, partitioning_->communicator(), &request_);
+}
+
+void ReductionBatch::finish()
+{
+  if (partitioning_->nRanks() == 1)
+    return;
+
+  MPI_Wait(&request_, MPI_STATUS_IGNORE);
+}
+
+double ReductionBatch::value(int index) const
+{
+  assert(0 <= index && index < int(entries_.size()));
+  assert(request_ == MPI_REQUEST_NULL);
+  return entries_[index].value;
+}
+
+void ReductionBatch::combine(void *invec, void *inoutvec, int *length, MPI_Datatype *)
+{
+  const Entry *in = static_cast<const Entry *>(invec);
+  Entry *inout = static_cast<Entry *>(inoutvec);
+  for (int index = 0; index < *length; index++)
+  {
+    switch (Operation(int(in[index].operation)))
+    {
+    case Operation::sum:
+      inout[index].value += in[index].value;
+      break;
+    case Operation::max:
+      inout[index].value = std::max(inout[index].value, in[index].value);
+      break;
+    case Operation::min:
+      inout[index].value = std::min(inout[index].value, in[index].value);
+      break;
+    }
+  }
+}
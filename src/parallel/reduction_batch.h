@@ -0,0 +1,94 @@
+#pragma once
+
+#include "partitioning.h"
+
+#include <memory>
+#include <vector>
+#include <mpi.h>
+
+/**
+ * @class ReductionBatch
+ * @brief Collects global scalars with their own reduction operation and reduces all of them in one message.
+ *
+ * The entries are pairs of the value and its operation, reduced with a user-defined MPI operation
+ * that applies the operation of every entry. A sync point therefore costs a single MPI_Allreduce,
+ * or a single MPI_Iallreduce that is in flight while other work is done, independent of the number of scalars.
+ * With a single rank no MPI calls are made, the values already are the global ones.
+ */
+class ReductionBatch
+{
+public:
+  //! reduction operation of one entry
+  enum class Operation
+  {
+    sum,
+    max,
+    min
+  };
+
+  /**
+   * @brief Constructor.
+   *
+   * @param partitioning ranks that take part in the reduction
+   */
+  ReductionBatch(std::shared_ptr<Partitioning> partitioning);
+
+  //! free the operation and the datatype
+  ~ReductionBatch();
+
+  //! a pending reduction refers to the entries, the batch cannot be copied
+  ReductionBatch(const ReductionBatch &) = delete;
+  ReductionBatch &operator=(const ReductionBatch &) = delete;
+
+  /**
+   * @brief remove all entries, for the next sync point
+   */
+  void clear();
+
+  /**
+   * @brief add a local value, returns its index to get the global value after the reduction
+   */
+  int add(double value, Operation operation);
+
+  /**
+   * @brief reduce all entries over all ranks, blocking
+   */
+  void reduce();
+
+  /**
+   * @brief start the reduction of all entries and return without waiting, no entries may be added until finish
+   */
+  void begin();
+
+  /**
+   * @brief wait for the reduction started with begin
+   */
+  void finish();
+
+  /**
+   * @brief value of an entry, the global value after reduce or finish
+   *
+   * @param index index returned by add
+   */
+  double value(int index) const;
+
+private:
+  /**
+   * @struct Entry
+   * @brief value and its operation, the operation is stored as double to send both in one datatype
+   */
+  struct Entry
+  {
+    double value;     //!< local, after the reduction global value
+    double operation; //!< the Operation as number
+  };
+
+  //! user-defined MPI operation, combines every entry of invec into inoutvec with the operation of the entry
+  static void combine(void *invec, void *inoutvec, int *length, MPI_Datatype *datatype);
+
+  std::shared_ptr<Partitioning> partitioning_; //!< ranks that take part in the reduction
+  std::vector<Entry> entries_;                 //!< values of the current sync point
+  MPI_Datatype entryDatatype_;                 //!< datatype of Entry
+  MPI_Op operation_;                           //!< applies the operation of every entry
+  MPI_Request request_;                        //!< pending reduction started by begin
+};
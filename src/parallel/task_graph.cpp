@@ -0,0 +1,57 @@
+#include "task_graph.h"
+
+#include <cassert>
+
+int TaskGraph::add(Task task, const std::vector<int> &dependencies)
+{
+  const int id = tasks_.size();
+  tasks_.push_back(std::move(task));
+  successors_.emplace_back();
+  nDependencies_.push_back(dependencies.size());
+  for (int dependency : dependencies)
+  {
+    assert(0 <= dependency && dependency < id);
+    successors_[dependency].push_back(id);
+  }
+  return id;
+}
+
+int TaskGraph::size() const
+{
+  return tasks_.size();
+}
+
+void TaskGraph::run()
+{
+  const int nTasks = tasks_.size();
+  nRemaining_ = std::make_unique<std::atomic<int>[]>(nTasks);
+  for (int task = 0; task < nTasks; task++)
+    nRemaining_[task] = nDependencies_[task];
+
+  // one thread starts the tasks without dependencies, all threads execute them and their successors,
+  // the end of the parallel region waits for all tasks
+#pragma omp parallel if (nTasks > 1)
+#pragma omp single
+  {
+    for (int task = 0; task < nTasks; task++)
+    {
+      if (nDependencies_[task] == 0)
+        execute(task);
+    }
+  }
+}
+
+void TaskGraph::execute(int task)
+{
+#pragma omp task firstprivate(task)
+  {
+    tasks_[task]();
+
+    // the last completed dependency makes a successor ready
+    for (int successor : successors_[task])
+    {
+      if (nRemaining_[successor].fetch_sub(1) == 1)
+        execute(successor);
+    }
+  }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../storage/iteration.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @class TaskGraph
+ * @brief Tasks with dependencies that are executed by the threads of the own rank
+ *
+ * A task becomes ready when all tasks it depends on are completed. The ready tasks are handed to the
+ * OpenMP runtime, whose idle threads take them, so independent phases do not wait for each other
+ * at the barrier of a parallel loop. Without OpenMP the tasks are executed one after another
+ * in an order that respects the dependencies.
+ */
+class TaskGraph
+{
+public:
+  using Task = std::function<void()>;
+
+  /**
+   * @brief add a task
+   *
+   * @param task work of the task, the referenced data has to outlive run
+   * @param dependencies tasks that have to be completed before this task starts
+   * @return id of the task, to be used in the dependencies of later tasks
+   */
+  int add(Task task, const std::vector<int> &dependencies = {});
+
+  /**
+   * @brief add one task per tile of a range, every task calls kernel(i, j) for the cells of its tile
+   *
+   * The tiles are the ones of a threaded traversal, see splitIntoTiles.
+   *
+   * @param range range of indices to split into tiles
+   * @param kernel called with (i, j), the kernel has to outlive run
+   * @param dependencies tasks that have to be completed before the tiles start
+   * @param policy tile size and vectorization
+   * @return ids of the tasks of the tiles
+   */
+  template <typename Layout = DefaultLayout, typename Kernel>
+  std::vector<int> addForEach(const IndexRange &range, Kernel &kernel, const std::vector<int> &dependencies = {},
+                              const IterationPolicy &policy = IterationPolicy::independent());
+
+  /**
+   * @brief execute all tasks and return when they are completed, afterwards the graph may be run again
+   */
+  void run();
+
+  //! number of tasks
+  int size() const;
+
+private:
+  //! execute a ready task and make its successors ready
+  void execute(int task);
+
+  std::vector<Task> tasks_;                          //!< work of every task
+  std::vector<std::vector<int>> successors_;         //!< tasks that depend on every task
+  std::vector<int> nDependencies_;                   //!< number of tasks every task depends on
+  std::unique_ptr<std::atomic<int>[]> nRemaining_;   //!< number of uncompleted dependencies during run
+};
+
+template <typename Layout, typename Kernel>
+std::vector<int> TaskGraph::addForEach(const IndexRange &range, Kernel &kernel, const std::vector<int> &dependencies,
+                                       const IterationPolicy &policy)
+{
+  std::vector<int> ids;
+  for (const IndexRange &tile : splitIntoTiles<Layout>(range, policy))
+  {
+    const bool vectorize = policy.vectorize;
+    ids.push_back(add([&kernel, tile, vectorize]()
+                      { forEachInTile(tile, kernel, vectorize); },
+                      dependencies));
+  }
+  return ids;
+}
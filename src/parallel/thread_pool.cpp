@@ -0,0 +1,144 @@
+#include "thread_pool.h"
+#include "../storage/iteration.h"
+
+#include <algorithm>
+#include <cassert>
+#include <mpi.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+ThreadPool::ThreadPool([[maybe_unused]] int nThreads, bool pinThreads, int bytesPerCell) :
+  nThreads_(1),
+  nIoThreads_(1)
+{
+  assert(nThreads >= 0);
+  assert(bytesPerCell > 0);
+
+#ifdef _OPENMP
+  // a team of fixed size, such that the runtime keeps reusing the same (pinned) threads
+  omp_set_dynamic(0);
+  if (nThreads > 0)
+    omp_set_num_threads(nThreads);
+  nThreads_ = omp_get_max_threads();
+#endif
+
+  if (pinThreads)
+    pin();
+
+  // the cache sizes are not known on every system, typical values otherwise
+  long level1Size = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+  long level2Size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (level1Size <= 0)
+    level1Size = 32 * 1024;
+  if (level2Size <= 0)
+    level2Size = 1024 * 1024;
+  IterationPolicy::threadTileSize = cacheSizedTile(bytesPerCell, level1Size, level2Size);
+}
+
+int ThreadPool::nThreads() const
+{
+  return nThreads_;
+}
+
+const std::vector<int> &ThreadPool::cores() const
+{
+  return cores_;
+}
+
+const std::vector<int> &ThreadPool::ioCores() const
+{
+  return ioCores_;
+}
+
+int ThreadPool::nIoThreads() const
+{
+  return nIoThreads_;
+}
+
+std::array<int, 2> ThreadPool::cacheSizedTile(int bytesPerCell, long level1Size, long level2Size)
+{
+  // a 5-point stencil reads three rows of the tile, a multiple of the SIMD width
+  const int width = std::max<long>(16, level1Size / (3 * bytesPerCell) / 16 * 16);
+
+  // half of L2 for the tile, the other half for the rows around it and the other threads' data
+  const int height = std::max<long>(1, level2Size / 2 / (long(width) * bytesPerCell));
+  return {width, height};
+}
+
+void ThreadPool::pin()
+{
+#ifdef __linux__
+  // the cores the launcher gave the rank, thread t gets the t-th of them
+  cpu_set_t available;
+  CPU_ZERO(&available);
+  if (sched_getaffinity(0, sizeof(available), &available) != 0)
+    return;
+
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+  {
+    if (CPU_ISSET(cpu, &available))
+      cpus.push_back(cpu);
+  }
+  if (cpus.empty())
+    return;
+
+  // if the launcher did not bind the ranks, all ranks of the node see the same cores,
+  // then the ranks take consecutive groups of them, wrapping around if there are more threads than cores
+  int localRankNo = 0;
+  int isInitialized = 0;
+  MPI_Initialized(&isInitialized);
+  MPI_Comm nodeCommunicator = MPI_COMM_NULL;
+  if (isInitialized)
+  {
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &nodeCommunicator);
+    MPI_Comm_rank(nodeCommunicator, &localRankNo);
+  }
+  const int first = (localRankNo * nThreads_) % cpus.size();
+
+  cores_.resize(nThreads_);
+  for (int thread = 0; thread < nThreads_; thread++)
+    cores_[thread] = cpus[(first + thread) % cpus.size()];
+
+  // the cores of the rank that no thread of the node is bound to are left for the I/O, else it shares all cores of the rank
+  cpu_set_t used;
+  CPU_ZERO(&used);
+  for (int core : cores_)
+    CPU_SET(core, &used);
+  if (nodeCommunicator != MPI_COMM_NULL)
+  {
+    MPI_Allreduce(MPI_IN_PLACE, &used, sizeof(used), MPI_BYTE, MPI_BOR, nodeCommunicator);
+    MPI_Comm_free(&nodeCommunicator);
+  }
+  for (int cpu : cpus)
+  {
+    if (!CPU_ISSET(cpu, &used))
+      ioCores_.push_back(cpu);
+  }
+  nIoThreads_ = std::max<int>(1, ioCores_.size());
+  if (ioCores_.empty())
+    ioCores_ = cpus;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThreads_)
+#endif
+  {
+#ifdef _OPENMP
+    const int thread = omp_get_thread_num();
+#else
+    const int thread = 0;
+#endif
+    cpu_set_t own;
+    CPU_ZERO(&own);
+    CPU_SET(cores_[thread], &own);
+    sched_setaffinity(0, sizeof(own), &own);
+  }
+#endif
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Threads of the own rank that share the loops over the subdomain
+ *
+ * The threads are the team of the OpenMP runtime, which is kept alive between the parallel
+ * regions of forEachInterior, forEachOfColour and reduceInterior. The pool fixes the size of the
+ * team, binds every thread to one core of the rank and sets the size of the tiles the threads get.
+ * MPI is called by one thread at a time (MPI_THREAD_SERIALIZED), by the master outside of the
+ * parallel regions or by the task of a TaskGraph that begins a halo exchange.
+ * Without OpenMP the pool consists of the master thread only.
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief Constructor, configures the threads for all following loops
+   *
+   * @param nThreads number of threads, 0: OMP_NUM_THREADS or all cores the rank may run on
+   * @param pinThreads bind thread t to the t-th core of the rank
+   * @param bytesPerCell bytes of the field variables touched per cell by a loop, determines the tile size
+   */
+  ThreadPool(int nThreads, bool pinThreads, int bytesPerCell);
+
+  //! number of threads of the rank
+  int nThreads() const;
+
+  //! cores the threads are bound to, empty if they are not pinned
+  const std::vector<int> &cores() const;
+
+  //! cores for a background I/O thread: those of the rank without a thread of the node, else all of the rank, empty if not pinned
+  const std::vector<int> &ioCores() const;
+
+  //! size of the OpenMP team of a background I/O thread, the number of free cores of the rank, at least 1
+  int nIoThreads() const;
+
+  /**
+   * @brief tile size such that the rows a stencil reads from a tile stay in L1 and the tile in L2
+   *
+   * @param bytesPerCell bytes of the field variables touched per cell
+   * @param level1Size size of the L1 data cache in bytes
+   * @param level2Size size of the L2 cache in bytes
+   */
+  static std::array<int, 2> cacheSizedTile(int bytesPerCell, long level1Size, long level2Size);
+
+private:
+  //! bind every thread of the team to one of the cores the rank may run on
+  void pin();
+
+  int nThreads_;           //!< number of threads of the rank
+  std::vector<int> cores_;   //!< core of every thread, empty if not pinned
+  std::vector<int> ioCores_; //!< cores the I/O thread may run on, empty if not pinned
+  int nIoThreads_;           //!< threads of the I/O thread's team, 1 if no core is free
+};
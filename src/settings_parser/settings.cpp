@@ -1,5 +1,38 @@
 #include "settings.h"
 
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+    /**
+     * @brief split a comma-separated list of numbers, e.g. "0.5,1,2.5"
+     */
+    std::vector<double> parseList(std::string value)
+    {
+        std::vector<double> list;
+        std::stringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+                list.push_back(atof(item.c_str()));
+        }
+        return list;
+    }
+
+    /**
+     * @brief print the triggers of a cadence, e.g. "interval: 0.5, stepInterval: 0, times: 1 2, onSteadyState: false"
+     */
+    std::ostream &operator<<(std::ostream &stream, const OutputCadence &cadence)
+    {
+        stream << "interval: " << cadence.interval << ", stepInterval: " << cadence.stepInterval << ", times:";
+        for (double time : cadence.times)
+            stream << " " << time;
+        return stream << ", onSteadyState: " << std::boolalpha << cadence.onSteadyState;
+    }
+}
+
 void Settings::loadFromFile(std::string filename)
 {
 
@@ -47,7 +80,22 @@ void Settings::printSettings()
               << ", left: (" << dirichletBcLeft[0] << "," << dirichletBcLeft[1] << ")"
               << ", right: (" << dirichletBcRight[0] << "," << dirichletBcRight[1] << ")" << std::endl
               << "  useDonorCell: " << std::boolalpha << useDonorCell << ", alpha: " << alpha << std::endl
-              << "  pressureSolver: " << pressureSolver << ", omega: " << omega << ", epsilon: " << epsilon << ", maximumNumberOfIterations: " << maximumNumberOfIterations << std::endl;
+              << "  pressureSolver: " << pressureSolver << ", omega: " << omega << ", epsilon: " << epsilon << ", maximumNumberOfIterations: " << maximumNumberOfIterations << ", haloWidth: " << haloWidth << std::endl
+              << "  precision: " << precision << ", paraviewOutput: " << paraviewOutput << ", asyncOutput: " << asyncOutput
+              << ", paraviewRegion:";
+    for (double coordinate : paraviewRegion)
+        std::cout << " " << coordinate;
+    std::cout << ", paraviewStride: " << paraviewStride
+              << ", paraviewPrecision: " << paraviewPrecision << ", paraviewCompression: " << paraviewCompression << ", paraviewTolerance: " << paraviewTolerance
+              << ", paraviewKeyframeInterval: " << paraviewKeyframeInterval << ", paraviewChangeThreshold: " << paraviewChangeThreshold << std::endl
+              << "  nThreads: " << nThreads << ", pinThreads: " << pinThreads << ", useHugePages: " << useHugePages << std::endl
+              << "  paraview output: " << paraviewCadence << std::endl
+              << "  text output: " << textCadence << std::endl
+              << "  probe output: " << probeCadence << ", steadyStateTolerance: " << steadyStateTolerance << std::endl
+              << "  probes:";
+    for (const std::array<double, 2> &probe : probes)
+        std::cout << " (" << probe[0] << "," << probe[1] << ")";
+    std::cout << std::endl;
 }
 
 Settings::LineContent Settings::readSingleLine(std::string line)
@@ -164,4 +212,159 @@ void Settings::setParameter(std::string parameterName, std::string value)
         Settings::epsilon = atof(value.c_str());
     else if (parameterName == "maximumNumberOfIterations")
         Settings::maximumNumberOfIterations = atof(value.c_str());
+    else if (parameterName == "haloWidth")
+    {
+        Settings::haloWidth = atoi(value.c_str());
+        if (Settings::haloWidth < 1)
+            throw std::invalid_argument("haloWidth has to be at least 1.");
+    }
+
+    // Precision of field storage and arithmetic
+    else if (parameterName == "precision")
+    {
+        if (value == "double" || value == "float" || value == "mixed")
+            Settings::precision = value;
+        else
+            throw std::invalid_argument("Supported values for precision are double, float and mixed.");
+    }
+
+    // Output
+    else if (parameterName == "paraviewOutput")
+    {
+        if (value == "pieces" || value == "shared" || value == "vtk" || value == "stream")
+            Settings::paraviewOutput = value;
+        else
+            throw std::invalid_argument("Supported values for paraviewOutput are pieces, shared, vtk and stream.");
+    }
+    else if (parameterName == "asyncOutput")
+    {
+        if (value == "true" || value == "True")
+            Settings::asyncOutput = true;
+        else if (value == "false" || value == "False")
+            Settings::asyncOutput = false;
+        else
+            throw std::invalid_argument("asyncOutput must be a boolean (true or false).");
+    }
+
+    else if (parameterName == "paraviewRegion")
+    {
+        Settings::paraviewRegion = parseList(value);
+        if (!paraviewRegion.empty() && (paraviewRegion.size() != 4 || paraviewRegion[2] < paraviewRegion[0] || paraviewRegion[3] < paraviewRegion[1]))
+            throw std::invalid_argument("paraviewRegion must be the corners x0,y0,x1,y1 of a box with x0 <= x1 and y0 <= y1.");
+    }
+    else if (parameterName == "paraviewStride")
+    {
+        Settings::paraviewStride = atoi(value.c_str());
+        if (Settings::paraviewStride < 1)
+            throw std::invalid_argument("paraviewStride must be at least 1.");
+    }
+    else if (parameterName == "paraviewPrecision")
+    {
+        if (value == "float64" || value == "float32" || value == "quantized16")
+            Settings::paraviewPrecision = value;
+        else
+            throw std::invalid_argument("Supported values for paraviewPrecision are float64, float32 and quantized16.");
+    }
+    else if (parameterName == "paraviewCompression")
+    {
+        if (value == "none" || value == "lz4" || value == "shuffle" || value == "lossy")
+            Settings::paraviewCompression = value;
+        else
+            throw std::invalid_argument("Supported values for paraviewCompression are none, lz4, shuffle and lossy.");
+    }
+    else if (parameterName == "paraviewTolerance")
+    {
+        Settings::paraviewTolerance = atof(value.c_str());
+        if (!(Settings::paraviewTolerance > 0))
+            throw std::invalid_argument("paraviewTolerance must be positive.");
+    }
+    else if (parameterName == "paraviewKeyframeInterval")
+    {
+        Settings::paraviewKeyframeInterval = atoi(value.c_str());
+        if (Settings::paraviewKeyframeInterval < 1)
+            throw std::invalid_argument("paraviewKeyframeInterval must be at least 1.");
+    }
+    else if (parameterName == "paraviewChangeThreshold")
+    {
+        Settings::paraviewChangeThreshold = atof(value.c_str());
+        if (Settings::paraviewChangeThreshold < 0)
+            throw std::invalid_argument("paraviewChangeThreshold must not be negative.");
+    }
+
+    // Threads of every rank
+    else if (parameterName == "nThreads")
+    {
+        Settings::nThreads = atoi(value.c_str());
+        if (Settings::nThreads < 0)
+            throw std::invalid_argument("nThreads must not be negative.");
+    }
+    else if (parameterName == "pinThreads")
+    {
+        if (value == "true" || value == "True")
+            Settings::pinThreads = true;
+        else if (value == "false" || value == "False")
+            Settings::pinThreads = false;
+        else
+            throw std::invalid_argument("pinThreads must be a boolean (true or false).");
+    }
+    else if (parameterName == "useHugePages")
+    {
+        if (value == "true" || value == "True")
+            Settings::useHugePages = true;
+        else if (value == "false" || value == "False")
+            Settings::useHugePages = false;
+        else
+            throw std::invalid_argument("useHugePages must be a boolean (true or false).");
+    }
+
+    // Output schedules and probes
+    else if (parameterName == "probe")
+    {
+        const std::vector<double> coordinates = parseList(value);
+        if (coordinates.size() != 2)
+            throw std::invalid_argument("probe must be the coordinates x,y of a point.");
+        Settings::probes.push_back({coordinates[0], coordinates[1]});
+    }
+    else if (parameterName == "steadyStateTolerance")
+        Settings::steadyStateTolerance = atof(value.c_str());
+    else if (setCadenceParameter("paraview", Settings::paraviewCadence, parameterName, value) ||
+             setCadenceParameter("text", Settings::textCadence, parameterName, value) ||
+             setCadenceParameter("probe", Settings::probeCadence, parameterName, value))
+    {
+        // the trigger has been set by setCadenceParameter
+    }
+}
+
+bool Settings::setCadenceParameter(std::string writer, OutputCadence &cadence, std::string parameterName, std::string value)
+{
+    if (parameterName == writer + "Interval")
+    {
+        cadence.interval = atof(value.c_str());
+        if (cadence.interval < 0)
+            throw std::invalid_argument(parameterName + " must not be negative.");
+    }
+    else if (parameterName == writer + "StepInterval")
+    {
+        cadence.stepInterval = atoi(value.c_str());
+        if (cadence.stepInterval < 0)
+            throw std::invalid_argument(parameterName + " must not be negative.");
+    }
+    else if (parameterName == writer + "Times")
+    {
+        cadence.times = parseList(value);
+        std::sort(cadence.times.begin(), cadence.times.end());
+    }
+    else if (parameterName == writer + "OnSteadyState")
+    {
+        if (value == "true" || value == "True")
+            cadence.onSteadyState = true;
+        else if (value == "false" || value == "False")
+            cadence.onSteadyState = false;
+        else
+            throw std::invalid_argument(parameterName + " must be a boolean (true or false).");
+    }
+    else
+        return false;
+
+    return true;
 }
@@ -5,6 +5,20 @@
 #include <fstream>
 #include <iostream>
 #include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @struct OutputCadence
+ * @brief When a writer writes its output, every trigger that is set causes an output, 0 or empty disables a trigger
+ */
+struct OutputCadence
+{
+  double interval = 0.0;       //!< simulated time between two outputs
+  int stepInterval = 0;        //!< number of time steps between two outputs
+  std::vector<double> times;   //!< explicit simulated times of outputs
+  bool onSteadyState = false;  //!< output once when the velocities become steady
+};
 
 /**
  * @struct Settings
@@ -33,6 +47,30 @@ struct Settings
   double omega = 1.0;                  //!< overrelaxation factor
   double epsilon = 1e-5;               //!< tolerance for the residual in the pressure solver
   int maximumNumberOfIterations = 1e5; //!< maximum number of iterations in the solver
+  int haloWidth = 1;                   //!< ghost layers of the pressure solver, colours between two halo exchanges
+
+  std::string precision = "double"; //!< scalar types of the simulation, "double", "float" or "mixed" (float storage, double arithmetic)
+
+  std::string paraviewOutput = "pieces"; //!< "pieces": a vti file per rank and a pvti file, "shared": one vti file written with MPI-IO,
+                                         //!< "vtk": the pieces written with the VTK library, "stream": frames of one stream file
+  bool asyncOutput = true;               //!< write the vti files on a background thread while the simulation continues
+  std::vector<double> paraviewRegion;         //!< x0,y0,x1,y1 of the box of the nodes in the vti files, empty for the whole domain
+  int paraviewStride = 1;                     //!< only every paraviewStride-th node of the region is written
+  std::string paraviewPrecision = "float64";   //!< type of the values in the vti files: "float64", "float32" or "quantized16"
+  std::string paraviewCompression = "none"; //!< compression of the pieces: "none", "lz4", "shuffle" (lossless) or "lossy"
+  double paraviewTolerance = 1e-6;          //!< maximum absolute error of the lossy compression
+  int paraviewKeyframeInterval = 10;        //!< every paraviewKeyframeInterval-th frame of the stream is stored in full
+  double paraviewChangeThreshold = 0.0;     //!< outputs that changed less relative to the last written one are skipped, 0: off
+
+  OutputCadence paraviewCadence{0.0, 1, {}, false}; //!< when the vti files are written, every time step by default
+  OutputCadence textCadence{0.0, 1, {}, false};     //!< when the debugging txt files are written, every time step by default
+  OutputCadence probeCadence{0.0, 1, {}, false};    //!< when the values at the probes are written, every time step by default
+  std::vector<std::array<double, 2>> probes; //!< points at which u, v and p are recorded over time
+  double steadyStateTolerance = 1e-5;    //!< velocities are steady if the maximum of |du/dt| and |dv/dt| is below
+
+  int nThreads = 0;        //!< threads per rank, 0: OMP_NUM_THREADS or all cores the rank may run on
+  bool pinThreads = true;  //!< bind every thread to one core of the rank
+  bool useHugePages = false; //!< back large field variables with 2 MB transparent huge pages
 
   /**
    * @brief Parse a text file with settings.
@@ -72,4 +110,16 @@ struct Settings
    * @param value of parameter
    */
   void setParameter(std::string parameterName, std::string value);
+
+  /**
+   * @brief Sets a trigger of an output cadence, parameters are <writer>Interval, <writer>StepInterval,
+   *        <writer>Times and <writer>OnSteadyState
+   *
+   * @param writer name of the writer the cadence belongs to, e.g. "paraview"
+   * @param cadence cadence of the writer
+   * @param parameterName parameter name
+   * @param value of parameter
+   * @return if the parameter belongs to the cadence
+   */
+  bool setCadenceParameter(std::string writer, OutputCadence &cadence, std::string parameterName, std::string value);
 };
\ No newline at end of file
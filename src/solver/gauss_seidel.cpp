@@ -1,39 +1,71 @@
 #include "gauss_seidel.h"
+#include <utility>
 
-GaussSeidel::GaussSeidel(const std::shared_ptr<Discretization> &data,
-                         double epsilon,
-                         int maximumNumberOfIterations) : PressureSolver(data, epsilon, maximumNumberOfIterations)
+template <typename T, typename A>
+GaussSeidel<T, A>::GaussSeidel(const std::shared_ptr<Discretization<T, A>> &data,
+                               double epsilon,
+                               int maximumNumberOfIterations,
+                               int ghostWidth) : PressureSolver<T, A>(data, epsilon, maximumNumberOfIterations, ghostWidth)
 {
 }
 
-void GaussSeidel::solve()
+template <typename T, typename A>
+void GaussSeidel<T, A>::solve()
 {
-    setBoundaryValues();
+    beginSolve();
 
     int n = 0;
     double res = epsilon_ + 1;
 
-    double d_fac = (dx2 * dy2) / (2 * (dx2 + dy2));
+    A d_fac = A((dx2 * dy2) / (2 * (dx2 + dy2)));
+    const A dx2Inv = A(1 / dx2);
+    const A dy2Inv = A(1 / dy2);
+
+    const FieldView<T> p = pressure().view();
+    const FieldView<const T> rhs = rightHandSide().view();
+
+    // new value of a cell from its left, right, lower and upper neighbour and rhs
+    auto relax = [=](T pLeft, T pRight, T pBottom, T pTop, T rhsCentre) -> T
+    {
+        A p_x = dx2Inv * (A(pRight) + pLeft);
+        A p_y = dy2Inv * (A(pTop) + pBottom);
+
+        return d_fac * (p_x + p_y - rhsCentre);
+    };
     do
     {
-        for (int i = i_beg; i < i_end; i++)
+        // in-place red-black update, the ghost layer is exchanged after every ghost width colours
+        for (int colour = 0; colour < 2; colour++)
         {
-            for (int j = j_beg; j < j_end; j++)
+            // the rows of the row-major layout are passed as restrict-qualified pointers, the blocked layouts use the views
+            if constexpr (FieldView<T>::hasRows)
             {
-
-                double p_x = 1 / dx2 * (discretization_->p(i + 1, j) + discretization_->p(i - 1, j));
-                double p_y = 1 / dy2 * (discretization_->p(i, j + 1) + discretization_->p(i, j - 1));
-
-                discretization_->p(i, j) = d_fac * (p_x + p_y - discretization_->rhs(i, j));
+                const int stride = p.stride();
+                sweepColour(colour, onRows([=](int i, T *pRow, const T *rhsRow)
+                                           { pRow[i] = relax(pRow[i - 1], pRow[i + 1], pRow[i - stride], pRow[i + stride], rhsRow[i]); },
+                                           p, rhs));
+            }
+            else
+            {
+                sweepColour(colour, [&](int i, int j)
+                            { p(i, j) = relax(p(i - 1, j), p(i + 1, j), p(i, j - 1), p(i, j + 1), rhs(i, j)); });
             }
         }
         setBoundaryValues();
-        // Compute the residual with new values
-        res = calculateResiduum();
+        // Compute the residual with new values, it needs the exchanged ghost layer
+        if (ghostLayerIsCurrent())
+            res = calculateResiduum();
         n++;
     } while (n < maximumNumberOfIterations_ && res > epsilon_);
+    endSolve();
 
 #ifndef NDEBUG
-    std::cout << "[Solver] Number of iterations: " << n << ", final residuum: " << res << std::endl;
+    if (partitioning_->ownRankNo() == 0)
+        std::cout << "[Solver] Number of iterations: " << n << ", final residuum: " << res << std::endl;
 #endif
 }
+
+// storage and accumulation types: double, float and mixed precision
+template class GaussSeidel<double, double>;
+template class GaussSeidel<float, float>;
+template class GaussSeidel<float, double>;
@@ -7,8 +7,11 @@
  * @class GaussSeidel
  * @brief Standard Gauss-Seidel solver
  *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which the stencil updates are evaluated
  */
-class GaussSeidel : public PressureSolver
+template <typename T = double, typename A = T>
+class GaussSeidel : public PressureSolver<T, A>
 {
 
 public:
@@ -18,13 +21,35 @@ public:
      * @param data instance of Discretization holding the needed field variables for rhs and p
      * @param epsilon tolerance for the solver
      * @param maximumNumberOfIterations maximum of iteration
+     * @param ghostWidth number of ghost layers, i.e. colours that are updated between two halo exchanges
      */
-    GaussSeidel(const std::shared_ptr<Discretization> &data,
+    GaussSeidel(const std::shared_ptr<Discretization<T, A>> &data,
                 double epsilon,
-                int maximumNumberOfIterations);
+                int maximumNumberOfIterations,
+                int ghostWidth = 1);
     /**
      * @brief override function that starts solver.
      *
      */
     void solve() override;
+
+protected:
+    using PressureSolver<T, A>::beginSolve;
+    using PressureSolver<T, A>::endSolve;
+    using PressureSolver<T, A>::setBoundaryValues;
+    using PressureSolver<T, A>::calculateResiduum;
+    using PressureSolver<T, A>::ghostLayerIsCurrent;
+    using PressureSolver<T, A>::pressure;
+    using PressureSolver<T, A>::rightHandSide;
+    using PressureSolver<T, A>::sweepColour;
+    using PressureSolver<T, A>::partitioning_;
+    using PressureSolver<T, A>::discretization_;
+    using PressureSolver<T, A>::epsilon_;
+    using PressureSolver<T, A>::maximumNumberOfIterations_;
+    using PressureSolver<T, A>::i_beg;
+    using PressureSolver<T, A>::i_end;
+    using PressureSolver<T, A>::j_beg;
+    using PressureSolver<T, A>::j_end;
+    using PressureSolver<T, A>::dx2;
+    using PressureSolver<T, A>::dy2;
 };
\ No newline at end of file
@@ -1,66 +1,201 @@
 #include "pressure_solver.h"
 #include <math.h>
+#include <algorithm>
 #include <iostream>
+#include <functional>
+#include <stdexcept>
+#include <utility>
 
-PressureSolver::PressureSolver(std::shared_ptr<Discretization> discretization,
-                               double epsilon,
-                               int maximumNumberOfIterations) : discretization_(discretization),
-                                                                epsilon_(epsilon),
-                                                                maximumNumberOfIterations_(maximumNumberOfIterations)
+template <typename T, typename A>
+PressureSolver<T, A>::PressureSolver(std::shared_ptr<Discretization<T, A>> discretization,
+                                     double epsilon,
+                                     int maximumNumberOfIterations,
+                                     int ghostWidth) : discretization_(discretization),
+                                                       epsilon_(epsilon),
+                                                       maximumNumberOfIterations_(maximumNumberOfIterations),
+                                                       partitioning_(discretization->partitioning()),
+                                                       ghostWidth_(ghostWidth),
+                                                       nColoursSinceExchange_(0),
+                                                       haloExchange_(partitioning_, ghostWidth > 1, ghostWidth),
+                                                       residualReduction_(partitioning_)
 {
     assert(epsilon > 0);
     assert(maximumNumberOfIterations > 0);
+    assert(ghostWidth >= 1);
 
-    // loop boundaries
-    i_beg = discretization_->rhsIBegin();
-    i_end = discretization_->rhsIEnd();
-    j_beg = discretization_->rhsJBegin();
-    j_end = discretization_->rhsJEnd();
+    // the neighbours send ghostWidth of their own layers, the smallest subdomain has to have as many
+    const std::array<int, 2> nCellsGlobal = partitioning_->nCellsGlobal();
+    const std::array<int, 2> nSubdomains = partitioning_->nSubdomains();
+    for (int dimension = 0; dimension < 2; dimension++)
+    {
+        if (nSubdomains[dimension] > 1 && ghostWidth > nCellsGlobal[dimension] / nSubdomains[dimension])
+            throw std::invalid_argument("The ghost width of the pressure solver must not exceed the number of cells of a subdomain.");
+    }
+
+    // loop boundaries, in the indexing of the field variables with ghostWidth ghost layers
+    i_beg = discretization_->rhsIBegin() + ghostWidth - 1;
+    i_end = discretization_->rhsIEnd() + ghostWidth - 1;
+    j_beg = discretization_->rhsJBegin() + ghostWidth - 1;
+    j_end = discretization_->rhsJEnd() + ghostWidth - 1;
+
+    if (ghostWidth > 1)
+    {
+        const std::array<int, 2> size = {i_end + ghostWidth, j_end + ghostWidth};
+        const std::array<double, 2> meshWidth = {discretization_->dx(), discretization_->dy()};
+        pDeep_ = std::make_unique<FieldVariable<T>>(size, std::array<double, 2>{0, 0}, meshWidth);
+        rhsDeep_ = std::make_unique<FieldVariable<T>>(size, std::array<double, 2>{0, 0}, meshWidth);
+    }
 
     // squared mesh widths
     dx2 = pow(discretization_->dx(), 2);
     dy2 = pow(discretization_->dy(), 2);
 }
 
-void PressureSolver::setBoundaryValues()
+template <typename T, typename A>
+void PressureSolver<T, A>::beginSolve()
+{
+    nColoursSinceExchange_ = 0;
+
+    if (ghostWidth_ > 1)
+    {
+        // own cells of the discretization, the deep ghost layers are received from the neighbours
+        const FieldView<const T> p = std::as_const(*discretization_).p().view();
+        const FieldView<const T> rhs = std::as_const(*discretization_).rhs().view();
+        const FieldView<T> pDeep = pDeep_->view();
+        const FieldView<T> rhsDeep = rhsDeep_->view();
+        const int shift = ghostWidth_ - 1;
+        forEachInterior(extendedRange(0), [&](int i, int j)
+                        {
+                            pDeep(i, j) = p(i - shift, j - shift);
+                            rhsDeep(i, j) = rhs(i - shift, j - shift);
+                        },
+                        IterationPolicy::independent());
+
+        haloExchange_.begin(*pDeep_);
+        haloExchange_.begin(*rhsDeep_);
+        haloExchange_.finish();
+    }
+    setBoundaryValues();
+}
+
+template <typename T, typename A>
+void PressureSolver<T, A>::endSolve()
+{
+    if (ghostWidth_ == 1)
+        return;
+
+    // the last colours may have left the ghost layer out of date
+    if (!ghostLayerIsCurrent())
+    {
+        haloExchange_.exchange(*pDeep_);
+        nColoursSinceExchange_ = 0;
+        setBoundaryValues();
+    }
+
+    // own cells and the first ghost layer
+    const FieldView<T> p = discretization_->p().view();
+    const FieldView<const T> pDeep = std::as_const(*pDeep_).view();
+    const int shift = ghostWidth_ - 1;
+    forEachInterior({0, p.size()[0], 0, p.size()[1]}, [&](int i, int j)
+                    {
+                        p(i, j) = pDeep(i + shift, j + shift);
+                    },
+                    IterationPolicy::independent());
+}
+
+template <typename T, typename A>
+bool PressureSolver<T, A>::ghostLayerIsCurrent() const
 {
+    return nColoursSinceExchange_ == 0;
+}
+
+template <typename T, typename A>
+FieldVariable<T> &PressureSolver<T, A>::pressure()
+{
+    return ghostWidth_ > 1 ? *pDeep_ : discretization_->p();
+}
+
+template <typename T, typename A>
+const FieldVariable<T> &PressureSolver<T, A>::rightHandSide() const
+{
+    return ghostWidth_ > 1 ? *rhsDeep_ : std::as_const(*discretization_).rhs();
+}
+
+template <typename T, typename A>
+IndexRange PressureSolver<T, A>::extendedRange(int depth) const
+{
+    return {i_beg - (partitioning_->ownPartitionContainsLeftBoundary() ? 0 : depth),
+            i_end + (partitioning_->ownPartitionContainsRightBoundary() ? 0 : depth),
+            j_beg - (partitioning_->ownPartitionContainsBottomBoundary() ? 0 : depth),
+            j_end + (partitioning_->ownPartitionContainsTopBoundary() ? 0 : depth)};
+}
+
+template <typename T, typename A>
+void PressureSolver<T, A>::setBoundaryValues()
+{
+    const FieldView<T> p = pressure().view();
+
+    // also in the valid part of the ghost layer next to the neighbours, the colours read at most ghostWidth_ - 1 layers deep
+    const IndexRange range = extendedRange(std::min(ghostWidth_ - nColoursSinceExchange_, ghostWidth_ - 1));
 
     // Horizontal (without corners)
-    for (int i = i_beg; i < i_end; i++)
+    for (int i = range.iBegin; i < range.iEnd; i++)
     {
-        discretization_->p(i, j_beg - 1) = discretization_->p(i, j_beg);
-        discretization_->p(i, j_end) = discretization_->p(i, j_end - 1);
+        if (partitioning_->ownPartitionContainsBottomBoundary())
+            p(i, j_beg - 1) = p(i, j_beg);
+        if (partitioning_->ownPartitionContainsTopBoundary())
+            p(i, j_end) = p(i, j_end - 1);
     }
 
     // Vertical (without corners)
-    for (int j = j_beg - 1; j < j_end + 1; j++)
+    for (int j = range.jBegin - 1; j < range.jEnd + 1; j++)
     {
-        discretization_->p(i_beg - 1, j) = discretization_->p(i_beg, j);
-        discretization_->p(i_end, j) = discretization_->p(i_end - 1, j);
+        if (partitioning_->ownPartitionContainsLeftBoundary())
+            p(i_beg - 1, j) = p(i_beg, j);
+        if (partitioning_->ownPartitionContainsRightBoundary())
+            p(i_end, j) = p(i_end - 1, j);
     }
 }
 
-double PressureSolver::calculateResiduum()
+template <typename T, typename A>
+int PressureSolver<T, A>::localColour(int colour) const
+{
+    // global index = local index + node offset
+    const std::array<int, 2> offset = partitioning_->nodeOffset();
+    return (colour + offset[0] + offset[1]) % 2;
+}
+
+template <typename T, typename A>
+double PressureSolver<T, A>::calculateResiduum()
 {
-    // 2nd derivative of p in x, y
-    double pxx, pyy{0};
-    // residuum in a single point, to be added to sum of squares
-    double res_current_point{0};
-    // to be applied in square root to yield internal product
-    double sum_of_squares{0};
+    // number of points in rhs grid of the whole domain
+    const std::array<int, 2> nCellsGlobal = partitioning_->nCellsGlobal();
+    const double N = double(nCellsGlobal[0]) * nCellsGlobal[1];
 
-    // number of points in rhs grid
-    int N = (j_end - j_beg) * (i_end - i_beg);
+    const FieldView<const T> p = std::as_const(pressure()).view();
+    const FieldView<const T> rhs = rightHandSide().view();
+    const A dx2A = A(dx2);
+    const A dy2A = A(dy2);
 
-    for (int i = i_beg; i < i_end; i++)
+    // squared residuum in a single point, the sum of squares is always accumulated in double
+    auto squaredResiduum = [&](int i, int j)
     {
-        for (int j = j_beg; j < j_end; j++)
-        {
-            pxx = (discretization_->p(i - 1, j) - 2 * discretization_->p(i, j) + discretization_->p(i + 1, j)) / dx2;
-            pyy = (discretization_->p(i, j - 1) - 2 * discretization_->p(i, j) + discretization_->p(i, j + 1)) / dy2;
-            res_current_point = pxx + pyy - discretization_->rhs(i, j);
-            sum_of_squares += pow(res_current_point, 2);
-        }
-    }
+        A pxx = (p(i - 1, j) - A(2) * p(i, j) + p(i + 1, j)) / dx2A;
+        A pyy = (p(i, j - 1) - A(2) * p(i, j) + p(i, j + 1)) / dy2A;
+        double res_current_point = pxx + pyy - rhs(i, j);
+        return res_current_point * res_current_point;
+    };
+    double sum_of_squares = reduceInterior({i_beg, i_end, j_beg, j_end}, 0.0, squaredResiduum, std::plus<double>(),
+                                           IterationPolicy::independent());
+    residualReduction_.clear();
+    const int entry = residualReduction_.add(sum_of_squares, ReductionBatch::Operation::sum);
+    residualReduction_.reduce();
+    sum_of_squares = residualReduction_.value(entry);
+
     return sqrt(sum_of_squares / N);
-}
\ No newline at end of file
+}
+
+// storage and accumulation types: double, float and mixed precision
+template class PressureSolver<double, double>;
+template class PressureSolver<float, float>;
+template class PressureSolver<float, double>;
@@ -1,6 +1,9 @@
 #pragma once
 #include "../storage/field_variable.h"
 #include "../discretization/discretization.h"
+#include "../storage/iteration.h"
+#include "../parallel/halo_exchange.h"
+#include "../parallel/reduction_batch.h"
 #include <memory>
 
 /**
@@ -10,7 +13,21 @@
  * Interface for the pressure solver. It computes the
  * pressure field variable such that the continuity equation
  * is fulfilled.
+ *
+ * The cells are updated in red-black order, after each colour the ghost layer of p
+ * is exchanged with the neighbouring subdomains. Therefore the iterates do not depend
+ * on the number of subdomains. The exchange is in flight while the inner cells are updated.
+ *
+ * With a ghost width k > 1 the solver works on copies of p and rhs with k ghost layers.
+ * After an exchange, k colours are updated without communication, each one also in the part of the
+ * ghost layer that is still valid, which shrinks by one layer per colour. The iterates are the same
+ * as with a single ghost layer, but the residual can only be evaluated after an exchange, i.e. every
+ * k / 2 iterations for even k and every k iterations for odd k.
+ *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which the stencil updates are evaluated
  */
+template <typename T = double, typename A = T>
 class PressureSolver
 {
 public:
@@ -20,10 +37,12 @@ public:
      * @param discretization instance of Discretization holding the needed field variables for rhs and p
      * @param epsilon tolerance for the solver
      * @param maximumNumberOfIterations maximum of iteration
+     * @param ghostWidth number of ghost layers, i.e. colours that are updated between two halo exchanges
      */
-    PressureSolver(std::shared_ptr<Discretization> discretization,
+    PressureSolver(std::shared_ptr<Discretization<T, A>> discretization,
                    double epsilon,
-                   int maximumNumberOfIterations);
+                   int maximumNumberOfIterations,
+                   int ghostWidth = 1);
 
     /**
      * @brief virtual function that starts solver.
@@ -34,27 +53,115 @@ public:
     double dx2, dy2; //!< squared mesh widths
 
 protected:
+    /**
+     * @brief prepare the field variables the solver works on and set the boundary values
+     *
+     * Has to be called at the start of solve.
+     */
+    void beginSolve();
+
+    /**
+     * @brief complete the ghost layer and store the result in p of the discretization
+     *
+     * Has to be called at the end of solve.
+     */
+    void endSolve();
+
     /**
      * @brief Set the Boundary Values
      *
-     * Account for homogenous Neuman BC
+     * Account for homogenous Neuman BC on the boundary of the domain
      * Has to be called every iteration
      */
     void setBoundaryValues();
 
     /**
-     * @brief calculate residuum of current time step
+     * @brief calculate residuum of current time step over all subdomains
+     *
+     * Only valid if ghostLayerIsCurrent().
      */
     double calculateResiduum();
 
+    /**
+     * @brief if the ghost layer has been exchanged after the last colour, such that the residual can be evaluated
+     */
+    bool ghostLayerIsCurrent() const;
+
+    /**
+     * @brief pressure the solver works on, p of the discretization or its copy with the deep ghost layer
+     */
+    FieldVariable<T> &pressure();
+
+    /**
+     * @brief right hand side the solver works on, rhs of the discretization or its copy with the deep ghost layer
+     */
+    const FieldVariable<T> &rightHandSide() const;
+
+    /**
+     * @brief colour of the cells in the local indexing of the own subdomain
+     *
+     * @param colour 0 (red) or 1 (black), the parity of the global cell indices
+     */
+    int localColour(int colour) const;
+
+    /**
+     * @brief update the cells of the next colour and exchange the ghost layer with the neighbouring subdomains when it is used up
+     *
+     * The colours are updated alternately, starting with red in every iteration. The update also covers
+     * the part of the ghost layer that is still valid. Before an exchange, the cells next to the ghost layer
+     * are updated first, then the exchange is begun and the inner cells are updated while the messages are in flight.
+     *
+     * @param colour 0 (red) or 1 (black), the parity of the global cell indices
+     * @param kernel update of p(i, j), only reads the cells of the other colour
+     */
+    template <typename Kernel>
+    void sweepColour(int colour, Kernel &&kernel);
+
+    /**
+     * @brief own cells and the cells of the ghost layer up to the given depth next to the neighbouring subdomains
+     */
+    IndexRange extendedRange(int depth) const;
+
     int i_beg; //!< begin of loop for rhs in x direction
     int i_end; //!< end   of loop for rhs in x direction
     int j_beg; //!< begin of loop for rhs in y direction
     int j_end; //!< end   of loop for rhs in y direction
 
-    std::shared_ptr<Discretization> discretization_; //!< object holding the needed field variables for rhs and p
+    std::shared_ptr<Discretization<T, A>> discretization_; //!< object holding the needed field variables for rhs and p
 
     double epsilon_; //!< tolerance for the solver
 
     int maximumNumberOfIterations_; //!< maximum number of iterations
-};
\ No newline at end of file
+
+    std::shared_ptr<Partitioning> partitioning_; //!< subdomain of the discretization
+    int ghostWidth_;                             //!< number of ghost layers, colours between two exchanges
+    int nColoursSinceExchange_;                  //!< number of colours updated since the last exchange
+    std::unique_ptr<FieldVariable<T>> pDeep_;    //!< copy of p with the deep ghost layer, only if ghostWidth_ > 1
+    std::unique_ptr<FieldVariable<T>> rhsDeep_;  //!< copy of rhs with the deep ghost layer, only if ghostWidth_ > 1
+    HaloExchange<T> haloExchange_;               //!< exchanges the ghost layer of p
+    ReductionBatch residualReduction_;           //!< global sum of the squared residuals
+};
+
+template <typename T, typename A>
+template <typename Kernel>
+void PressureSolver<T, A>::sweepColour(int colour, Kernel &&kernel)
+{
+    const int local = localColour(colour);
+    nColoursSinceExchange_++;
+
+    // the valid part of the ghost layer shrinks by one layer per colour
+    if (nColoursSinceExchange_ < ghostWidth_)
+    {
+        forEachOfColour(extendedRange(ghostWidth_ - nColoursSinceExchange_), local, kernel, IterationPolicy::independent());
+        return;
+    }
+
+    const IndexRange range = extendedRange(0);
+    for (const IndexRange &strip : boundaryStrips(range, ghostWidth_))
+        forEachOfColour(strip, local, kernel, IterationPolicy::independent());
+
+    haloExchange_.begin(pressure());
+    forEachOfColour(innerRange(range, ghostWidth_), local, kernel, IterationPolicy::independent());
+    haloExchange_.finish();
+    nColoursSinceExchange_ = 0;
+}
@@ -1,41 +1,73 @@
 #include "sor.h"
 #include <iostream>
+#include <utility>
 
-SOR::SOR(const std::shared_ptr<Discretization> &data,
-         double epsilon,
-         int maximumNumberOfIterations,
-         double omega) : PressureSolver(data, epsilon, maximumNumberOfIterations), omega_(omega)
+template <typename T, typename A>
+SOR<T, A>::SOR(const std::shared_ptr<Discretization<T, A>> &data,
+               double epsilon,
+               int maximumNumberOfIterations,
+               double omega,
+               int ghostWidth) : PressureSolver<T, A>(data, epsilon, maximumNumberOfIterations, ghostWidth), omega_(omega)
 {
 }
 
-void SOR::solve()
+template <typename T, typename A>
+void SOR<T, A>::solve()
 {
-    setBoundaryValues();
-    double p_x, p_y;
+    beginSolve();
     int n = 0;
     double res = epsilon_ + 1;
 
-    double d_fac = (dx2 * dy2) / (2 * (dx2 + dy2));
+    A d_fac = A((dx2 * dy2) / (2 * (dx2 + dy2)));
+    const A dx2Inv = A(1 / dx2);
+    const A dy2Inv = A(1 / dy2);
+    const A omega = omega_;
+
+    const FieldView<T> p = pressure().view();
+    const FieldView<const T> rhs = rightHandSide().view();
+
+    // new value of a cell from the old one, its left, right, lower and upper neighbour and rhs
+    auto relax = [=](T pCentre, T pLeft, T pRight, T pBottom, T pTop, T rhsCentre) -> T
+    {
+        A p_x = dx2Inv * (A(pRight) + pLeft);
+        A p_y = dy2Inv * (A(pTop) + pBottom);
+
+        return (A(1) - omega) * pCentre + omega * (d_fac * (p_x + p_y - rhsCentre));
+    };
     do
     {
-        for (int i = i_beg; i < i_end; i++)
+        // in-place red-black update, the ghost layer is exchanged after every ghost width colours
+        for (int colour = 0; colour < 2; colour++)
         {
-            for (int j = j_beg; j < j_end; j++)
+            // the rows of the row-major layout are passed as restrict-qualified pointers, the blocked layouts use the views
+            if constexpr (FieldView<T>::hasRows)
             {
-
-                p_x = 1 / dx2 * (discretization_->p(i + 1, j) + discretization_->p(i - 1, j));
-                p_y = 1 / dy2 * (discretization_->p(i, j + 1) + discretization_->p(i, j - 1));
-
-                discretization_->p(i, j) = (1 - omega_) * discretization_->p(i, j) + omega_ * (d_fac * (p_x + p_y - discretization_->rhs(i, j)));
+                const int stride = p.stride();
+                sweepColour(colour, onRows([=](int i, T *pRow, const T *rhsRow)
+                                           { pRow[i] = relax(pRow[i], pRow[i - 1], pRow[i + 1], pRow[i - stride], pRow[i + stride], rhsRow[i]); },
+                                           p, rhs));
+            }
+            else
+            {
+                sweepColour(colour, [&](int i, int j)
+                            { p(i, j) = relax(p(i, j), p(i - 1, j), p(i + 1, j), p(i, j - 1), p(i, j + 1), rhs(i, j)); });
             }
         }
         setBoundaryValues();
-        // Compute the residual with new values
-        res = calculateResiduum();
+        // Compute the residual with new values, it needs the exchanged ghost layer
+        if (ghostLayerIsCurrent())
+            res = calculateResiduum();
         n++;
     } while (n < maximumNumberOfIterations_ && res > epsilon_);
+    endSolve();
 
 #ifndef NDEBUG
-    std::cout << "[Solver] Number of iterations: " << n << ", final residuum: " << res << std::endl;
+    if (partitioning_->ownRankNo() == 0)
+        std::cout << "[Solver] Number of iterations: " << n << ", final residuum: " << res << std::endl;
 #endif
 }
+
+// storage and accumulation types: double, float and mixed precision
+template class SOR<double, double>;
+template class SOR<float, float>;
+template class SOR<float, double>;
@@ -6,8 +6,11 @@
  * @class SOR
  * @brief Successive over-relaxation solver
  *
+ * @tparam T scalar type used to store the field variables
+ * @tparam A scalar type in which the stencil updates are evaluated
  */
-class SOR : public PressureSolver
+template <typename T = double, typename A = T>
+class SOR : public PressureSolver<T, A>
 {
 
 public:
@@ -18,11 +21,13 @@ public:
      * @param epsilon tolerance for the solver
      * @param maximumNumberOfIterations maximum of iteration
      * @param omega relaxation factor
+     * @param ghostWidth number of ghost layers, i.e. colours that are updated between two halo exchanges
      */
-    SOR(const std::shared_ptr<Discretization> &data,
+    SOR(const std::shared_ptr<Discretization<T, A>> &data,
         double epsilon,
         int maximumNumberOfIterations,
-        double omega);
+        double omega,
+        int ghostWidth = 1);
 
     /**
      * @brief override function that starts solver.
@@ -30,6 +35,26 @@ public:
      */
     void solve() override;
 
+protected:
+    using PressureSolver<T, A>::beginSolve;
+    using PressureSolver<T, A>::endSolve;
+    using PressureSolver<T, A>::setBoundaryValues;
+    using PressureSolver<T, A>::calculateResiduum;
+    using PressureSolver<T, A>::ghostLayerIsCurrent;
+    using PressureSolver<T, A>::pressure;
+    using PressureSolver<T, A>::rightHandSide;
+    using PressureSolver<T, A>::sweepColour;
+    using PressureSolver<T, A>::partitioning_;
+    using PressureSolver<T, A>::discretization_;
+    using PressureSolver<T, A>::epsilon_;
+    using PressureSolver<T, A>::maximumNumberOfIterations_;
+    using PressureSolver<T, A>::i_beg;
+    using PressureSolver<T, A>::i_end;
+    using PressureSolver<T, A>::j_beg;
+    using PressureSolver<T, A>::j_end;
+    using PressureSolver<T, A>::dx2;
+    using PressureSolver<T, A>::dy2;
+
 private:
-    double omega_; //!< relaxation factor for SOR
+    A omega_; //!< relaxation factor for SOR
 };
\ No newline at end of file
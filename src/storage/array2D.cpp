@@ -1,36 +1,70 @@
 #include "array2D.h"
 
-Array2D::Array2D(std::array<int, 2> size) : size_(size)
+template <typename T, typename Layout>
+Array2D<T, Layout>::Array2D(std::array<int, 2> size) : size_(size), layout_(size)
 {
   assert(size[0] > 0 && size[1] > 0);
-  data_.resize(size_[0] * size_[1], 0.0);
+
+  // allocate without writing, then first touch in the static distribution of the threaded loops,
+  // which traverse the storage in order: every thread gets a contiguous part of it
+  data_.resize(layout_.storageSize());
+  T *data = data_.data();
+  const int storageSize = data_.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int index = 0; index < storageSize; index++)
+    data[index] = T(0);
 }
 
-double &Array2D::operator()(int i, int j)
+template <typename T, typename Layout>
+T &Array2D<T, Layout>::operator()(int i, int j)
 {
-  const int index = j * size_[0] + i;
+  const int index = layout_.index(i, j);
 
   // Assert that indices are inside size of array
   assert(0 <= i && i < size_[0]);
   assert(0 <= j && j < size_[1]);
-  assert(j * size_[0] + i < (int)data_.size());
+  assert(index < (int)data_.size());
 
   return data_[index];
 }
 
-double Array2D::operator()(int i, int j) const
+template <typename T, typename Layout>
+T Array2D<T, Layout>::operator()(int i, int j) const
 {
-  const int index = j * size_[0] + i;
+  const int index = layout_.index(i, j);
 
   // Assert that indices are inside size of array
   assert(0 <= i && i < size_[0]);
   assert(0 <= j && j < size_[1]);
-  assert(j * size_[0] + i < (int)data_.size());
+  assert(index < (int)data_.size());
 
   return data_[index];
 }
 
-std::array<int, 2> Array2D::size() const
+template <typename T, typename Layout>
+std::array<int, 2> Array2D<T, Layout>::size() const
 {
   return size_;
 }
+
+template <typename T, typename Layout>
+FieldView<T, Layout> Array2D<T, Layout>::view()
+{
+  return FieldView<T, Layout>(data_.data(), layout_, size_);
+}
+
+template <typename T, typename Layout>
+FieldView<const T, Layout> Array2D<T, Layout>::view() const
+{
+  return FieldView<const T, Layout>(data_.data(), layout_, size_);
+}
+
+// scalar types used for the field storage, with all available layouts
+template class Array2D<float, RowMajorLayout>;
+template class Array2D<double, RowMajorLayout>;
+template class Array2D<float, TiledLayout<>>;
+template class Array2D<double, TiledLayout<>>;
+template class Array2D<float, MortonLayout>;
+template class Array2D<double, MortonLayout>;
@@ -3,14 +3,24 @@
 #include <vector>
 #include <array>
 #include <cassert>
+#include "layout.h"
+#include "field_view.h"
+#include "field_allocator.h"
 
 /**
  * @class Array2D
- * @brief This class represents a 2D array of double values.
+ * @brief This class represents a 2D array of scalar values.
  *
  * Internally they are stored consecutively in memory.
  * The entries can be accessed by two indices i,j.
+ * Where entry (i,j) is placed in memory is defined by the layout policy.
+ * The values are first written by the threads in the order of the loops over the
+ * array, such that the pages are placed on the NUMA node of the threads that use them.
+ *
+ * @tparam T scalar type of the stored values, e.g. float or double
+ * @tparam Layout memory layout, RowMajorLayout, TiledLayout or MortonLayout
  */
+template <typename T = double, typename Layout = DefaultLayout>
 class Array2D
 {
 public:
@@ -28,7 +38,7 @@ public:
      * @param i index in x direction
      * @param j index in y direction
      */
-    double &operator()(int i, int j);
+    T &operator()(int i, int j);
 
     /**
      * @brief get array value.
@@ -37,14 +47,25 @@ public:
      * @param i index in x direction
      * @param j index in y direction
      */
-    double operator()(int i, int j) const;
+    T operator()(int i, int j) const;
 
     /**
      * @brief get size of array in x and y direction
      */
     std::array<int, 2> size() const;
 
+    /**
+     * @brief get a non-owning view on the values for hot loops
+     */
+    FieldView<T, Layout> view();
+
+    /**
+     * @brief get a non-owning read-only view on the values for hot loops
+     */
+    FieldView<const T, Layout> view() const;
+
 protected:
     const std::array<int, 2> size_; //!< size of array in x and y direction
-    std::vector<double> data_;      //!< storage array values, in row-major order
-};
\ No newline at end of file
+    const Layout layout_;           //!< maps the indices (i,j) to the position in data_
+    std::vector<T, FieldAllocator<T>> data_; //!< storage array values, in the order given by the layout
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/**
+ * @struct FieldAllocation
+ * @brief Options for the storage of all field variables, set once at start-up before the fields are created
+ */
+struct FieldAllocation
+{
+    static inline bool useHugePages = false;                    //!< back large fields with transparent huge pages
+    static constexpr std::size_t hugePageSize = 2 * 1024 * 1024; //!< size of a huge page, 2 MB on x86-64 and most ARM systems
+    static constexpr std::size_t alignment = 64;                 //!< alignment of the other fields, one cache line
+};
+
+/**
+ * @class FieldAllocator
+ * @brief Allocator of the storage of Array2D that leaves the values uninitialized
+ *
+ * The memory is only mapped to a NUMA node when it is written first, so the values have to be
+ * initialized by the threads that later work on them. Resizing a vector with this allocator
+ * therefore does not write the values. Fields of at least a huge page are aligned to huge pages
+ * and, if FieldAllocation::useHugePages, advised to be backed by them.
+ *
+ * @tparam T scalar type of the stored values
+ */
+template <typename T>
+class FieldAllocator
+{
+public:
+    using value_type = T;
+
+    FieldAllocator() = default;
+
+    template <typename U>
+    FieldAllocator(const FieldAllocator<U> &)
+    {
+    }
+
+    /**
+     * @brief allocate uninitialized storage for n values
+     */
+    T *allocate(std::size_t n)
+    {
+        const std::size_t bytes = n * sizeof(T);
+        const bool isLarge = bytes >= FieldAllocation::hugePageSize;
+        const std::size_t alignment = isLarge ? FieldAllocation::hugePageSize : FieldAllocation::alignment;
+
+        // aligned_alloc needs a multiple of the alignment
+        const std::size_t paddedBytes = (bytes + alignment - 1) / alignment * alignment;
+        void *memory = std::aligned_alloc(alignment, paddedBytes);
+        if (memory == nullptr)
+            throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (isLarge && FieldAllocation::useHugePages)
+            madvise(memory, paddedBytes, MADV_HUGEPAGE);
+#endif
+        return static_cast<T *>(memory);
+    }
+
+    /**
+     * @brief free storage returned by allocate
+     */
+    void deallocate(T *pointer, std::size_t)
+    {
+        std::free(pointer);
+    }
+
+    /**
+     * @brief default-initialize instead of value-initialize, i.e. do not touch scalar values
+     */
+    template <typename U>
+    void construct(U *pointer)
+    {
+        ::new (static_cast<void *>(pointer)) U;
+    }
+
+    /**
+     * @brief construct with arguments, e.g. when a vector is copied
+     */
+    template <typename U, typename... Arguments>
+    void construct(U *pointer, Arguments &&...arguments)
+    {
+        ::new (static_cast<void *>(pointer)) U(std::forward<Arguments>(arguments)...);
+    }
+
+    template <typename U>
+    bool operator==(const FieldAllocator<U> &) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const FieldAllocator<U> &) const
+    {
+        return false;
+    }
+};
@@ -1,15 +1,24 @@
 #include "array2D.h"
 #include "field_variable.h"
+#include "iteration.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
-FieldVariable::FieldVariable(std::array<int, 2> size,
-                             std::array<double, 2> origin,
-                             std::array<double, 2> meshWidth) : Array2D::Array2D(size),
-                                                                origin_(origin),
-                                                                meshWidth_(meshWidth)
+template <typename T>
+FieldVariable<T>::FieldVariable(std::array<int, 2> size,
+                                std::array<double, 2> origin,
+                                std::array<double, 2> meshWidth) : Array2D<T>::Array2D(size),
+                                                                   origin_(origin),
+                                                                   meshWidth_(meshWidth)
 {
 }
 
-double FieldVariable::interpolateAt(double x, double y) const
+template <typename T>
+double FieldVariable<T>::interpolateAt(double x, double y) const
 {
     // reshape x and y to local coordinates
     double x_0 = x - origin_[0];
@@ -52,18 +61,79 @@ double FieldVariable::interpolateAt(double x, double y) const
     }
 }
 
-double FieldVariable::findAbsMax() const
+template <typename T>
+template <typename D>
+void FieldVariable<T>::interpolateToNodes(IndexRange nodes, D *destination, int stride, double offset, double scale,
+                                          int nodeStride) const
 {
-    double max = 0;
-    for (int i = 0; i < size_[0]; i++)
+    // node (i,j) lies between the values (i + iOffset, .) and (i + iOffset + 1, .) and the same in y direction
+    const double iShift = -origin_[0] / meshWidth_[0];
+    const double jShift = -origin_[1] / meshWidth_[1];
+    const int iOffset = int(std::floor(iShift));
+    const int jOffset = int(std::floor(jShift));
+    const double iWeight = iShift - iOffset;
+    const double jWeight = jShift - jOffset;
+
+    // the next value has no weight on a node in the same column or row, it may lie outside of the array
+    const int iNext = iWeight > 0 ? 1 : 0;
+    const int jNext = jWeight > 0 ? 1 : 0;
+
+    // with offset 0 and scale 1 the values are stored unchanged
+    const double inverseScale = 1.0 / scale;
+    const double maximum = std::is_integral<D>::value ? double(std::numeric_limits<D>::max()) : 0.0;
+
+    const FieldView<const T> field = this->view();
+    const int nNodesX = (nodes.iEnd - nodes.iBegin + nodeStride - 1) / nodeStride;
+    for (int j = nodes.jBegin; j < nodes.jEnd; j += nodeStride)
     {
-        for (int j = 0; j < size_[1]; j++)
+        D *row = destination + std::ptrdiff_t(stride) * ((j - nodes.jBegin) / nodeStride) * nNodesX;
+        const int jDown = j + jOffset;
+        const int jUp = jDown + jNext;
+
+#pragma omp simd
+        for (int nodeNo = 0; nodeNo < nNodesX; nodeNo++)
         {
-            if (std::abs((*this)(i, j)) > max)
-            {
-                max = std::abs((*this)(i, j));
-            }
+            const int iLeft = nodes.iBegin + nodeStride * nodeNo + iOffset;
+            const int iRight = iLeft + iNext;
+            const double downLeft = (1 - iWeight) * double(field(iLeft, jDown));
+            const double downRight = iWeight * double(field(iRight, jDown));
+            const double upLeft = (1 - iWeight) * double(field(iLeft, jUp));
+            const double upRight = iWeight * double(field(iRight, jUp));
+            const double value = ((1 - jWeight) * (downLeft + downRight) + jWeight * (upLeft + upRight) - offset) * inverseScale;
+            if constexpr (std::is_integral<D>::value)
+                row[stride * nodeNo] = D(std::min(std::max(value + 0.5, 0.0), maximum));
+            else
+                row[stride * nodeNo] = D(value);
         }
     }
+}
+
+template <typename T>
+double FieldVariable<T>::findAbsMax() const
+{
+    const FieldView<const T> field = this->view();
+
+    auto absValue = [&](int i, int j)
+    {
+        return std::abs(double(field(i, j)));
+    };
+    auto maximum = [](double a, double b)
+    {
+        return std::max(a, b);
+    };
+    double max = reduceInterior({0, this->size_[0], 0, this->size_[1]}, 0.0, absValue, maximum,
+                                IterationPolicy::independent());
     return max;
 }
+
+// scalar types used for the field storage
+template class FieldVariable<float>;
+template class FieldVariable<double>;
+
+// types of the output values
+template void FieldVariable<float>::interpolateToNodes(IndexRange, double *, int, double, double, int) const;
+template void FieldVariable<float>::interpolateToNodes(IndexRange, float *, int, double, double, int) const;
+template void FieldVariable<float>::interpolateToNodes(IndexRange, std::uint16_t *, int, double, double, int) const;
+template void FieldVariable<double>::interpolateToNodes(IndexRange, double *, int, double, double, int) const;
+template void FieldVariable<double>::interpolateToNodes(IndexRange, float *, int, double, double, int) const;
+template void FieldVariable<double>::interpolateToNodes(IndexRange, std::uint16_t *, int, double, double, int) const;
@@ -5,6 +5,7 @@
 #include <cmath>
 #include <iostream>
 #include "array2D.h"
+#include "iteration.h"
 
 /**
  * @class FieldVariable
@@ -13,8 +14,13 @@
  * A field variable is the discretization of a scalar function f(x) with x in the computational domain.
  * More specifically, a scalar value is stored at discrete nodes/points.
  * The nodes are arranged in an equidistant mesh with specified mesh width.
+ *
+ * Values are stored with scalar type T, interpolation and reductions are evaluated in double.
+ *
+ * @tparam T scalar type of the stored values, e.g. float or double
  */
-class FieldVariable : public Array2D
+template <typename T = double>
+class FieldVariable : public Array2D<T>
 {
 public:
     /**
@@ -36,6 +42,29 @@ public:
      */
     double interpolateAt(double x, double y) const;
 
+    /**
+     * @brief Interpolates the values at a range of nodes of the mesh, node (i,j) is at (i*dx, j*dy)
+     *
+     * The nodes are in the same position relative to the staggered values for all nodes, the indices
+     * of the neighbouring values and the weights of the bilinear interpolation are computed once
+     * and the rows of nodes are interpolated in vectorizable loops.
+     *
+     * The values are stored as (value - offset) / scale in the type of destination, e.g. float for output
+     * in single precision, integer types are rounded to the nearest integer and clamped to their range.
+     *
+     * @tparam D type of the stored values: double, float or std::uint16_t
+     * @param nodes range of node indices
+     * @param destination node (i,j) is stored at destination[stride * ((j - jBegin) * (iEnd - iBegin) + i - iBegin)],
+     *                    with a node stride the indices relative to the range are divided by it
+     * @param stride distance between two nodes in destination, e.g. 3 for the components of a vector
+     * @param offset value that is stored as 0
+     * @param scale difference of the values that are stored as 0 and 1
+     * @param nodeStride only every nodeStride-th node of the range in x and y direction, starting at (iBegin, jBegin)
+     */
+    template <typename D>
+    void interpolateToNodes(IndexRange nodes, D *destination, int stride = 1, double offset = 0.0, double scale = 1.0,
+                            int nodeStride = 1) const;
+
     /**
      * @brief Find point in Array2D of Fieldvariable with maximum value
      *
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <type_traits>
+#include <cassert>
+#include "layout.h"
+
+/**
+ * @class FieldView
+ * @brief Non-owning view on the values of an Array2D for hot loops.
+ *
+ * The view holds a raw restrict-qualified pointer to the storage and a copy of the layout,
+ * all accesses are defined in this header and are inlined at the call site.
+ * The array has to outlive the view, the view never allocates or frees memory.
+ * A restrict-qualified member does not tell the compiler that two views do not overlap,
+ * the rows of the row-major layout are therefore passed to the loops as restrict-qualified
+ * pointers (see onRows in iteration.h). Their stride can be fixed at compile time.
+ *
+ * @tparam T scalar type of the values, const T for a read-only view
+ * @tparam Layout memory layout of the viewed array
+ * @tparam Stride compile-time distance between two rows (row-major layout only), 0 if given at runtime
+ */
+template <typename T, typename Layout = DefaultLayout, int Stride = 0>
+class FieldView
+{
+    static_assert(Stride == 0 || std::is_same<Layout, RowMajorLayout>::value,
+                  "a compile-time stride is only possible for the row-major layout");
+
+public:
+    //! if the entries of a row are contiguous, such that row() and stride() are available
+    static constexpr bool hasRows = std::is_same<Layout, RowMajorLayout>::value;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param data pointer to the storage of the array
+     * @param layout layout of the array
+     * @param size size of array in x and y direction
+     */
+    FieldView(T *data, const Layout &layout, std::array<int, 2> size) : data_(data), layout_(layout), size_(size)
+    {
+        assert(Stride == 0 || Stride == size[0]);
+    }
+
+    /**
+     * @brief access value (i,j)
+     *
+     * @param i index in x direction
+     * @param j index in y direction
+     */
+    T &operator()(int i, int j) const
+    {
+        assert(0 <= i && i < size_[0]);
+        assert(0 <= j && j < size_[1]);
+        return data_[index(i, j)];
+    }
+
+    /**
+     * @brief pointer to entry (0,j), the entries of row j follow contiguously (row-major layout only)
+     *
+     * Bind it to a restrict-qualified local pointer or parameter in the loop over the row.
+     *
+     * @param j index in y direction
+     */
+    T *row(int j) const
+    {
+        static_assert(hasRows, "rows are only contiguous for the row-major layout");
+        assert(0 <= j && j < size_[1]);
+        return data_ + index(0, j);
+    }
+
+    /**
+     * @brief distance in memory between (i,j) and (i,j+1) (row-major layout only)
+     */
+    int stride() const
+    {
+        static_assert(hasRows, "the stride is only constant for the row-major layout");
+        return Stride > 0 ? Stride : layout_.index(0, 1);
+    }
+
+    /**
+     * @brief get size of viewed array in x and y direction
+     */
+    std::array<int, 2> size() const
+    {
+        return size_;
+    }
+
+private:
+    //! position of entry (i,j) in storage
+    int index(int i, int j) const
+    {
+        if constexpr (Stride > 0)
+            return j * Stride + i;
+        else
+            return layout_.index(i, j);
+    }
+
+    T *__restrict data_;            //!< storage of the viewed array, not owned
+    const Layout layout_;           //!< maps the indices (i,j) to the position in data_
+    const std::array<int, 2> size_; //!< size of viewed array in x and y direction
+};
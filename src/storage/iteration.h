@@ -0,0 +1,467 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "layout.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @struct IndexRange
+ * @brief Half-open range [iBegin, iEnd) x [jBegin, jEnd) of indices of a field variable
+ */
+struct IndexRange
+{
+    int iBegin; //!< first index in x direction
+    int iEnd;   //!< one past the last index in x direction
+    int jBegin; //!< first index in y direction
+    int jEnd;   //!< one past the last index in y direction
+};
+
+/**
+ * @struct IterationPolicy
+ * @brief Options how forEachInterior and reduceInterior traverse a range
+ *
+ * Threading and vectorization are only allowed for kernels whose cells do not depend on
+ * values written by the same sweep, in-place sweeps like Gauss-Seidel have to stay sequential.
+ */
+struct IterationPolicy
+{
+    int tileWidth = 0;      //!< number of cells of a tile in x direction, 0: blocks of the layout or whole rows
+    int tileHeight = 0;     //!< number of cells of a tile in y direction, 0: blocks of the layout or whole range
+    bool parallel = false;  //!< distribute the tiles on the OpenMP threads
+    bool vectorize = false; //!< let the compiler vectorize the inner loop without dependency checks
+
+    /**
+     * @brief size of the tiles that are distributed on the threads if neither the policy nor the layout has tiles
+     *
+     * {0, 0}: single rows. Set once at start-up by ThreadPool from the cache sizes.
+     */
+    static inline std::array<int, 2> threadTileSize = {0, 0};
+
+    /**
+     * @brief policy for kernels whose cells are independent of each other: threaded and vectorized
+     */
+    static IterationPolicy independent()
+    {
+        IterationPolicy policy;
+        policy.parallel = true;
+        policy.vectorize = true;
+        return policy;
+    }
+
+    /**
+     * @brief policy for in-place sweeps that read values written before in the same sweep
+     */
+    static IterationPolicy sequential()
+    {
+        return IterationPolicy();
+    }
+};
+
+/**
+ * @brief cells of a range that are at least width cells away from its edges, may be empty
+ */
+inline IndexRange innerRange(const IndexRange &range, int width)
+{
+    const int iBegin = std::min(range.iBegin + width, range.iEnd);
+    const int jBegin = std::min(range.jBegin + width, range.jEnd);
+    return {iBegin, std::max(range.iEnd - width, iBegin), jBegin, std::max(range.jEnd - width, jBegin)};
+}
+
+/**
+ * @brief cells of a range within width cells of its edges, the complement of innerRange
+ *
+ * The strip is split into the bottom and top rows over the whole width and the left and right
+ * columns between them, the four parts do not overlap and some of them may be empty.
+ */
+inline std::array<IndexRange, 4> boundaryStrips(const IndexRange &range, int width)
+{
+    const IndexRange inner = innerRange(range, width);
+    return {{{range.iBegin, range.iEnd, range.jBegin, inner.jBegin},
+             {range.iBegin, range.iEnd, inner.jEnd, range.jEnd},
+             {range.iBegin, inner.iBegin, inner.jBegin, inner.jEnd},
+             {inner.iEnd, range.iEnd, inner.jBegin, inner.jEnd}}};
+}
+
+/**
+ * @brief true if the tiles of a traversal are distributed on threads, only if built with OpenMP
+ */
+inline bool isThreaded([[maybe_unused]] const IterationPolicy &policy)
+{
+#ifdef _OPENMP
+    return policy.parallel;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @struct Tiling
+ * @brief Tiles of a range, numbered row by row, tile k is computed when it is needed instead of stored
+ */
+struct Tiling
+{
+    IndexRange range; //!< range that is split
+    int iFirst;       //!< first index of the first column of tiles, aligned to the tile width
+    int jFirst;       //!< first index of the first row of tiles, aligned to the tile height
+    int tileWidth;    //!< number of cells of a tile in x direction
+    int tileHeight;   //!< number of cells of a tile in y direction
+    int nTilesX;      //!< number of tiles in x direction
+    int nTiles;       //!< number of tiles, 0 if the range is empty
+
+    /**
+     * @brief the k-th tile, cut to the range
+     */
+    IndexRange tile(int k) const
+    {
+        const int i = iFirst + k % nTilesX * tileWidth;
+        const int j = jFirst + k / nTilesX * tileHeight;
+        return {std::max(i, range.iBegin), std::min(i + tileWidth, range.iEnd),
+                std::max(j, range.jBegin), std::min(j + tileHeight, range.jEnd)};
+    }
+};
+
+/**
+ * @brief tiling of a range into the tiles that are traversed one after another
+ *
+ * Tiles are aligned to multiples of the tile size, such that they coincide with the blocks
+ * of the layout, and are ordered row by row as the blocks are stored in memory.
+ *
+ * @tparam Layout memory layout of the traversed field variables
+ * @param range range of indices to split
+ * @param policy tile size and threading
+ */
+template <typename Layout = DefaultLayout>
+Tiling tilingOf(const IndexRange &range, const IterationPolicy &policy)
+{
+    if (range.iBegin >= range.iEnd || range.jBegin >= range.jEnd)
+        return {range, range.iBegin, range.jBegin, 1, 1, 1, 0};
+
+    int tileWidth = policy.tileWidth > 0 ? policy.tileWidth : Layout::blockSize[0];
+    int tileHeight = policy.tileHeight > 0 ? policy.tileHeight : Layout::blockSize[1];
+
+    // cache-sized tiles for the threads, but at least one row of tiles per thread
+    if (isThreaded(policy) && tileWidth <= 0 && tileHeight <= 0 && IterationPolicy::threadTileSize[1] > 0)
+    {
+#ifdef _OPENMP
+        const int nRowsPerThread = (range.jEnd - range.jBegin) / omp_get_max_threads();
+#else
+        const int nRowsPerThread = range.jEnd - range.jBegin;
+#endif
+        tileWidth = IterationPolicy::threadTileSize[0];
+        tileHeight = std::max(1, std::min(IterationPolicy::threadTileSize[1], nRowsPerThread));
+    }
+
+    // without tiles whole rows are traversed, threads get single rows
+    const int iFirst = tileWidth > 0 ? range.iBegin - range.iBegin % tileWidth : range.iBegin;
+    const int jFirst = tileHeight > 0 ? range.jBegin - range.jBegin % tileHeight : range.jBegin;
+    if (tileWidth <= 0)
+        tileWidth = range.iEnd - range.iBegin;
+    if (tileHeight <= 0)
+        tileHeight = isThreaded(policy) ? 1 : range.jEnd - range.jBegin;
+
+    const int nTilesX = (range.iEnd - iFirst + tileWidth - 1) / tileWidth;
+    const int nTilesY = (range.jEnd - jFirst + tileHeight - 1) / tileHeight;
+    return {range, iFirst, jFirst, tileWidth, tileHeight, nTilesX, nTilesX * nTilesY};
+}
+
+/**
+ * @brief split a range into the tiles of tilingOf, for callers that keep the tiles, e.g. as tasks
+ *
+ * @tparam Layout memory layout of the traversed field variables
+ * @param range range of indices to split
+ * @param policy tile size and threading
+ */
+template <typename Layout = DefaultLayout>
+std::vector<IndexRange> splitIntoTiles(const IndexRange &range, const IterationPolicy &policy)
+{
+    const Tiling tiling = tilingOf<Layout>(range, policy);
+    std::vector<IndexRange> tiles;
+    tiles.reserve(tiling.nTiles);
+    for (int tile = 0; tile < tiling.nTiles; tile++)
+        tiles.push_back(tiling.tile(tile));
+    return tiles;
+}
+
+/**
+ * @brief call kernel(i, j) for all cells of one tile, j outer and i inner
+ */
+template <typename Kernel>
+inline void forEachInTile(const IndexRange &tile, Kernel &kernel, bool vectorize)
+{
+    for (int j = tile.jBegin; j < tile.jEnd; j++)
+    {
+        if (vectorize)
+        {
+#pragma omp simd
+            for (int i = tile.iBegin; i < tile.iEnd; i++)
+                kernel(i, j);
+        }
+        else
+        {
+            for (int i = tile.iBegin; i < tile.iEnd; i++)
+                kernel(i, j);
+        }
+    }
+}
+
+/**
+ * @brief call kernel(i, j) for the cells of one tile with (i + j) % 2 == colour, j outer and i inner
+ */
+template <typename Kernel>
+inline void forEachOfColourInTile(const IndexRange &tile, int colour, Kernel &kernel, bool vectorize)
+{
+    for (int j = tile.jBegin; j < tile.jEnd; j++)
+    {
+        const int iFirst = tile.iBegin + ((tile.iBegin + j + colour) & 1);
+        if (vectorize)
+        {
+#pragma omp simd
+            for (int i = iFirst; i < tile.iEnd; i += 2)
+                kernel(i, j);
+        }
+        else
+        {
+            for (int i = iFirst; i < tile.iEnd; i += 2)
+                kernel(i, j);
+        }
+    }
+}
+
+/**
+ * @struct RowKernel
+ * @brief Kernel that works on the rows of row-major views instead of the views themselves, see onRows
+ */
+template <typename Kernel, typename... Views>
+struct RowKernel
+{
+    Kernel kernel;                      //!< called with (i, rows...) for the cells of a row
+    std::tuple<const Views &...> views; //!< views whose rows are passed to the kernel
+};
+
+/**
+ * @brief let the traversals pass the rows of row-major views to a kernel as restrict-qualified pointers
+ *
+ * For every row j the traversal calls kernel(i, rows...) with the rows views.row(j)..., the kernel accesses
+ * (i, j) as row[i] and (i, j +- 1) as row[i +- view.stride()]. The rows are parameters of the loop over i,
+ * so the compiler may assume that the field variables do not overlap and needs no runtime alias checks.
+ * The kernel must access every field variable only through its row and should capture its constants by
+ * value, the compiler cannot exclude that a write through a row changes a value captured by reference.
+ *
+ * @param kernel called with (i, rows...) for every cell
+ * @param views views of the field variables, in the order of the rows of the kernel
+ */
+template <typename Kernel, typename... Views>
+RowKernel<std::decay_t<Kernel>, Views...> onRows(Kernel &&kernel, const Views &...views)
+{
+    static_assert((Views::hasRows && ...), "rows are only contiguous for the row-major layout");
+    return {std::forward<Kernel>(kernel), std::tuple<const Views &...>(views...)};
+}
+
+/**
+ * @brief call kernel(i, rows...) for i = iBegin, iBegin + step, ... of one row
+ *
+ * Not inlined: GCC only derives the independence of the rows from the restrict-qualified parameters of the
+ * function it compiles, once inlined into the caller the loop is versioned with runtime alias checks again.
+ * The kernel is inlined into the loop, the call costs once per row.
+ */
+template <typename Kernel, typename... T>
+__attribute__((noinline)) void forEachInRow(int iBegin, int iEnd, int step, Kernel &kernel, bool vectorize, T *__restrict... rows)
+{
+    if (vectorize)
+    {
+        // the rows of one field variable are written at i and read at i +- stride, ivdep states the same without OpenMP
+#ifdef _OPENMP
+#pragma omp simd
+#else
+#pragma GCC ivdep
+#endif
+        for (int i = iBegin; i < iEnd; i += step)
+            kernel(i, rows...);
+    }
+    else
+    {
+        for (int i = iBegin; i < iEnd; i += step)
+            kernel(i, rows...);
+    }
+}
+
+/**
+ * @brief call the kernel for all cells of one tile with the rows of its views, j outer and i inner
+ */
+template <typename Kernel, typename... Views>
+inline void forEachInTile(const IndexRange &tile, RowKernel<Kernel, Views...> &kernel, bool vectorize)
+{
+    for (int j = tile.jBegin; j < tile.jEnd; j++)
+    {
+        std::apply([&](const Views &...views)
+                   { forEachInRow(tile.iBegin, tile.iEnd, 1, kernel.kernel, vectorize, views.row(j)...); },
+                   kernel.views);
+    }
+}
+
+/**
+ * @brief call the kernel for the cells of one tile with (i + j) % 2 == colour with the rows of its views
+ */
+template <typename Kernel, typename... Views>
+inline void forEachOfColourInTile(const IndexRange &tile, int colour, RowKernel<Kernel, Views...> &kernel, bool vectorize)
+{
+    for (int j = tile.jBegin; j < tile.jEnd; j++)
+    {
+        const int iFirst = tile.iBegin + ((tile.iBegin + j + colour) & 1);
+        std::apply([&](const Views &...views)
+                   { forEachInRow(iFirst, tile.iEnd, 2, kernel.kernel, vectorize, views.row(j)...); },
+                   kernel.views);
+    }
+}
+
+/**
+ * @brief combine kernel(i, j) of all cells of one tile, j outer and i inner
+ *
+ * If vectorized, every row is reduced into a fixed number of independent lanes,
+ * which the compiler maps to SIMD registers, and the lanes are combined in order at the end.
+ */
+template <typename Value, typename Kernel, typename Combine>
+inline Value reduceInTile(const IndexRange &tile, Value value, Kernel &kernel, Combine &combine, bool vectorize)
+{
+    if (!vectorize)
+    {
+        for (int j = tile.jBegin; j < tile.jEnd; j++)
+            for (int i = tile.iBegin; i < tile.iEnd; i++)
+                value = combine(value, kernel(i, j));
+        return value;
+    }
+
+    constexpr int nLanes = 8;
+    Value lanes[nLanes];
+    for (int lane = 0; lane < nLanes; lane++)
+        lanes[lane] = value;
+
+    for (int j = tile.jBegin; j < tile.jEnd; j++)
+    {
+        int i = tile.iBegin;
+        for (; i + nLanes <= tile.iEnd; i += nLanes)
+        {
+#pragma omp simd
+            for (int lane = 0; lane < nLanes; lane++)
+                lanes[lane] = combine(lanes[lane], kernel(i + lane, j));
+        }
+        for (; i < tile.iEnd; i++)
+            lanes[0] = combine(lanes[0], kernel(i, j));
+    }
+
+    value = lanes[0];
+    for (int lane = 1; lane < nLanes; lane++)
+        value = combine(value, lanes[lane]);
+    return value;
+}
+
+/**
+ * @brief true if a range is traversed as a whole, without tiles and threads
+ */
+template <typename Layout>
+inline bool isSingleTile(const IterationPolicy &policy)
+{
+    return !isThreaded(policy) && policy.tileWidth <= 0 && policy.tileHeight <= 0 &&
+           Layout::blockSize[0] <= 0 && Layout::blockSize[1] <= 0;
+}
+
+/**
+ * @brief call kernel(i, j) for all cells of a range in the order in which they are stored
+ *
+ * This is the only place where loops over field variables are nested. For the row-major layout
+ * the range is traversed row by row with i as the inner index, for the blocked layouts tile by tile.
+ *
+ * @tparam Layout memory layout of the traversed field variables
+ * @param range range of indices, usually the interior of a field variable
+ * @param kernel called with (i, j) for every cell of the range
+ * @param policy tiling, threading and vectorization
+ */
+template <typename Layout = DefaultLayout, typename Kernel>
+void forEachInterior(const IndexRange &range, Kernel &&kernel, const IterationPolicy &policy = IterationPolicy())
+{
+    if (isSingleTile<Layout>(policy))
+    {
+        forEachInTile(range, kernel, policy.vectorize);
+        return;
+    }
+
+    const Tiling tiling = tilingOf<Layout>(range, policy);
+
+#pragma omp parallel for schedule(static) if (isThreaded(policy))
+    for (int tile = 0; tile < tiling.nTiles; tile++)
+        forEachInTile(tiling.tile(tile), kernel, policy.vectorize);
+}
+
+/**
+ * @brief call kernel(i, j) for the cells of a range with (i + j) % 2 == colour, traversed as in forEachInterior
+ *
+ * The cells of one colour of the checkerboard only read cells of the other colour in a 5-point stencil.
+ * An in-place red-black sweep may therefore be threaded and vectorized.
+ *
+ * @tparam Layout memory layout of the traversed field variables
+ * @param range range of indices, usually the interior of a field variable
+ * @param colour 0 or 1, the parity of i + j of the visited cells
+ * @param kernel called with (i, j) for every cell of the colour
+ * @param policy tiling, threading and vectorization
+ */
+template <typename Layout = DefaultLayout, typename Kernel>
+void forEachOfColour(const IndexRange &range, int colour, Kernel &&kernel, const IterationPolicy &policy = IterationPolicy())
+{
+    if (isSingleTile<Layout>(policy))
+    {
+        forEachOfColourInTile(range, colour, kernel, policy.vectorize);
+        return;
+    }
+
+    const Tiling tiling = tilingOf<Layout>(range, policy);
+
+#pragma omp parallel for schedule(static) if (isThreaded(policy))
+    for (int tile = 0; tile < tiling.nTiles; tile++)
+        forEachOfColourInTile(tiling.tile(tile), colour, kernel, policy.vectorize);
+}
+
+/**
+ * @brief combine kernel(i, j) of all cells of a range, traversed as in forEachInterior
+ *
+ * Every tile is reduced on its own, the results of the tiles are combined in a fixed order,
+ * so the result does not depend on the number of threads. The kernel may also write
+ * the cell, this fuses an update with a reduction over the updated values.
+ *
+ * @tparam Layout memory layout of the traversed field variables
+ * @param range range of indices, usually the interior of a field variable
+ * @param identity neutral element of combine
+ * @param kernel called with (i, j) for every cell of the range, returns the value of the cell
+ * @param combine associative operation that combines two values
+ * @param policy tiling, threading and vectorization
+ */
+template <typename Layout = DefaultLayout, typename Value, typename Kernel, typename Combine>
+Value reduceInterior(const IndexRange &range, Value identity, Kernel &&kernel, Combine &&combine,
+                     const IterationPolicy &policy = IterationPolicy())
+{
+    if (isSingleTile<Layout>(policy))
+        return reduceInTile(range, identity, kernel, combine, policy.vectorize);
+
+    const Tiling tiling = tilingOf<Layout>(range, policy);
+
+    // the results of the tiles are kept in a buffer of the calling thread that is reused by its following calls
+    static thread_local std::vector<Value> buffer;
+    std::vector<Value> &partial = buffer;
+    partial.assign(tiling.nTiles, identity);
+
+#pragma omp parallel for schedule(static) if (isThreaded(policy))
+    for (int tile = 0; tile < tiling.nTiles; tile++)
+        partial[tile] = reduceInTile(tiling.tile(tile), identity, kernel, combine, policy.vectorize);
+
+    Value value = identity;
+    for (int tile = 0; tile < tiling.nTiles; tile++)
+        value = combine(value, partial[tile]);
+    return value;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+
+/**
+ * @class RowMajorLayout
+ * @brief Linear memory layout of an Array2D.
+ *
+ * Entries with consecutive index i are consecutive in memory,
+ * the rows (index j) are stored one after another.
+ */
+class RowMajorLayout
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param size size of array in x and y direction
+     */
+    RowMajorLayout(std::array<int, 2> size) : nx_(size[0]), storageSize_(size[0] * size[1])
+    {
+    }
+
+    //! block of entries that is contiguous in memory and should be traversed at once, 0: whole rows
+    static constexpr std::array<int, 2> blockSize = {0, 0};
+
+    /**
+     * @brief number of entries that have to be allocated
+     */
+    int storageSize() const
+    {
+        return storageSize_;
+    }
+
+    /**
+     * @brief position of entry (i,j) in storage
+     *
+     * @param i index in x direction
+     * @param j index in y direction
+     */
+    int index(int i, int j) const
+    {
+        return j * nx_ + i;
+    }
+
+private:
+    const int nx_;          //!< number of entries in x direction, the stride between two rows
+    const int storageSize_; //!< number of entries that have to be allocated
+};
+
+/**
+ * @class TiledLayout
+ * @brief Blocked memory layout of an Array2D.
+ *
+ * The array is divided into tiles of TileWidth x TileHeight entries. Each tile is
+ * stored contiguously in row-major order, the tiles themselves are stored row by row.
+ * Vertical neighbours inside a tile are only TileWidth entries apart.
+ * The array is padded to a multiple of the tile size.
+ *
+ * @tparam TileWidth number of entries of a tile in x direction, a power of two
+ * @tparam TileHeight number of entries of a tile in y direction, a power of two
+ */
+template <int TileWidth = 8, int TileHeight = 8>
+class TiledLayout
+{
+    static_assert(TileWidth > 0 && (TileWidth & (TileWidth - 1)) == 0, "TileWidth has to be a power of two");
+    static_assert(TileHeight > 0 && (TileHeight & (TileHeight - 1)) == 0, "TileHeight has to be a power of two");
+
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param size size of array in x and y direction
+     */
+    TiledLayout(std::array<int, 2> size) : nTilesX_((size[0] + TileWidth - 1) / TileWidth),
+                                           nTilesY_((size[1] + TileHeight - 1) / TileHeight)
+    {
+    }
+
+    //! block of entries that is contiguous in memory and should be traversed at once, one tile
+    static constexpr std::array<int, 2> blockSize = {TileWidth, TileHeight};
+
+    /**
+     * @brief number of entries that have to be allocated, including the padding of the last tiles
+     */
+    int storageSize() const
+    {
+        return nTilesX_ * nTilesY_ * TileWidth * TileHeight;
+    }
+
+    /**
+     * @brief position of entry (i,j) in storage
+     *
+     * @param i index in x direction
+     * @param j index in y direction
+     */
+    int index(int i, int j) const
+    {
+        // indices are non-negative, unsigned division by a power of two is a shift
+        const unsigned int iu = i;
+        const unsigned int ju = j;
+        const unsigned int tile = (ju / TileHeight) * nTilesX_ + iu / TileWidth;
+        return tile * (TileWidth * TileHeight) + (ju % TileHeight) * TileWidth + iu % TileWidth;
+    }
+
+private:
+    const int nTilesX_; //!< number of tiles in x direction
+    const int nTilesY_; //!< number of tiles in y direction
+};
+
+/**
+ * @class MortonLayout
+ * @brief Z-order (Morton) memory layout of an Array2D.
+ *
+ * The position in storage is obtained by interleaving the bits of i and j,
+ * which keeps entries that are close in both directions close in memory on every scale.
+ * The storage has to cover the Morton index of the last entry, therefore this layout
+ * is only economical for arrays that are close to square.
+ */
+class MortonLayout
+{
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param size size of array in x and y direction, each at most 2^15
+     */
+    MortonLayout(std::array<int, 2> size) : storageSize_(index(size[0] - 1, size[1] - 1) + 1)
+    {
+        assert(size[0] <= (1 << 15) && size[1] <= (1 << 15));
+    }
+
+    //! block of entries that is contiguous in memory and should be traversed at once, an aligned 8x8 square
+    static constexpr std::array<int, 2> blockSize = {8, 8};
+
+    /**
+     * @brief number of entries that have to be allocated
+     */
+    int storageSize() const
+    {
+        return storageSize_;
+    }
+
+    /**
+     * @brief position of entry (i,j) in storage
+     *
+     * @param i index in x direction
+     * @param j index in y direction
+     */
+    static int index(int i, int j)
+    {
+        return spreadBits(i) | (spreadBits(j) << 1);
+    }
+
+private:
+    /**
+     * @brief insert a zero bit between each of the lower 16 bits of x
+     */
+    static unsigned int spreadBits(unsigned int x)
+    {
+        x &= 0x0000ffff;
+        x = (x | (x << 8)) & 0x00ff00ff;
+        x = (x | (x << 4)) & 0x0f0f0f0f;
+        x = (x | (x << 2)) & 0x33333333;
+        x = (x | (x << 1)) & 0x55555555;
+        return x;
+    }
+
+    const int storageSize_; //!< number of entries that have to be allocated
+};
+
+// layout of all field variables, chosen at build time with NUMSIM_ARRAY_LAYOUT
+#if defined(NUMSIM_LAYOUT_TILED)
+using DefaultLayout = TiledLayout<>;
+#elif defined(NUMSIM_LAYOUT_MORTON)
+using DefaultLayout = MortonLayout;
+#else
+using DefaultLayout = RowMajorLayout;
+#endif
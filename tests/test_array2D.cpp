@@ -21,3 +21,58 @@ TEST(Array2D, InitializeArrayWithZeros){
     Array2D a(size);
     EXPECT_EQ(a(0,0), 0.0);
 };
+
+TEST(Array2D, FloatStorage){
+    std::array<int,2> size = {2,3};
+    Array2D<float> a(size);
+    a(1,2) = 0.5f;
+    EXPECT_EQ(a(0,0), 0.0f);
+    EXPECT_EQ(a(1,2), 0.5f);
+};
+
+TEST(Array2D, TiledAndMortonLayoutsKeepEntriesApart){
+    std::array<int,2> size = {11,19};
+    Array2D<double, TiledLayout<>> tiled(size);
+    Array2D<double, MortonLayout> morton(size);
+    for (int j = 0; j < size[1]; j++){
+        for (int i = 0; i < size[0]; i++){
+            tiled(i,j) = i + 100 * j;
+            morton(i,j) = i + 100 * j;
+        }
+    }
+    for (int j = 0; j < size[1]; j++){
+        for (int i = 0; i < size[0]; i++){
+            EXPECT_EQ(tiled(i,j), i + 100 * j);
+            EXPECT_EQ(morton(i,j), i + 100 * j);
+        }
+    }
+};
+
+TEST(Array2D, ViewSharesStorage){
+    std::array<int,2> size = {4,3};
+    Array2D<double, RowMajorLayout> a(size);
+    FieldView<double, RowMajorLayout> view = a.view();
+    view(2,1) = 3.0;
+    EXPECT_EQ(a(2,1), 3.0);
+    EXPECT_EQ(view.row(1)[2], 3.0);
+    EXPECT_EQ(view.stride(), 4);
+
+    FieldView<double, RowMajorLayout, 4> fixedStrideView(&a(0,0), RowMajorLayout(size), size);
+    fixedStrideView(3,2) = -1.0;
+    EXPECT_EQ(a(3,2), -1.0);
+    EXPECT_EQ(fixedStrideView.row(2)[3], -1.0);
+    EXPECT_EQ(fixedStrideView.stride(), 4);
+};
+
+TEST(Array2D, LargeArrayIsZeroAndAlignedToHugePages){
+    // 1024 x 512 doubles are 4 MB, more than a huge page
+    std::array<int,2> size = {1024,512};
+    Array2D a(size);
+    EXPECT_EQ(a(0,0), 0.0);
+    EXPECT_EQ(a(1023,511), 0.0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&a(0,0)) % FieldAllocation::hugePageSize, 0u);
+
+    // small arrays are aligned to cache lines
+    Array2D<float> b({3,3});
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&b(0,0)) % FieldAllocation::alignment, 0u);
+};
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../src/output_writer/block_codec.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+    // smooth field of nodes in rows of 300 nodes with 3 components, more than one block
+    std::vector<double> smoothField(){
+        std::vector<double> values;
+        for (int j = 0; j < 50; j++)
+            for (int i = 0; i < 300; i++){
+                values.push_back(std::sin(0.01 * i) * std::cos(0.02 * j));
+                values.push_back(0.5 * i * j);
+                values.push_back(0.0);
+            }
+        return values;
+    }
+}
+
+TEST(BlockCodec, Lz4RoundTrip){
+    std::vector<char> repetitive(100000);
+    for (std::size_t index = 0; index < repetitive.size(); index++)
+        repetitive[index] = char(index % 37);
+    std::vector<char> compressed = BlockCodec::compressLz4(repetitive.data(), repetitive.size());
+    EXPECT_LT(compressed.size(), repetitive.size() / 10);
+    EXPECT_EQ(BlockCodec::decompressLz4(compressed.data(), compressed.size(), repetitive.size()), repetitive);
+
+    // random bytes do not compress, short inputs have no matches at all
+    std::mt19937 generator(3);
+    std::vector<char> random(5000);
+    for (char &byte : random)
+        byte = char(generator());
+    for (std::size_t size : {std::size_t(0), std::size_t(7), std::size_t(13), random.size()}){
+        compressed = BlockCodec::compressLz4(random.data(), size);
+        EXPECT_EQ(BlockCodec::decompressLz4(compressed.data(), compressed.size(), size),
+                  std::vector<char>(random.begin(), random.begin() + size));
+    }
+};
+
+TEST(BlockCodec, LosslessRoundTrip){
+    const std::vector<double> values = smoothField();
+    for (BlockCodec::Method method : {BlockCodec::Method::lz4, BlockCodec::Method::shuffle}){
+        BlockCodec codec(method);
+        std::vector<char> encoded = codec.encode(reinterpret_cast<const char *>(values.data()), values.size(), sizeof(double), 3, 900);
+        EXPECT_LT(encoded.size(), sizeof(double) * values.size());
+        std::vector<char> decoded = codec.decode(encoded.data(), encoded.size(), sizeof(double), 3, 900);
+        ASSERT_EQ(decoded.size(), sizeof(double) * values.size());
+        EXPECT_EQ(std::memcmp(decoded.data(), values.data(), decoded.size()), 0);
+
+        // values of single precision
+        std::vector<float> floats(values.begin(), values.end());
+        encoded = codec.encode(reinterpret_cast<const char *>(floats.data()), floats.size(), sizeof(float), 3, 900);
+        decoded = codec.decode(encoded.data(), encoded.size(), sizeof(float), 3, 900);
+        ASSERT_EQ(decoded.size(), sizeof(float) * floats.size());
+        EXPECT_EQ(std::memcmp(decoded.data(), floats.data(), decoded.size()), 0);
+    }
+};
+
+TEST(BlockCodec, LossyErrorWithinTolerance){
+    const std::vector<double> values = smoothField();
+    const double tolerance = 1e-4;
+    BlockCodec codec(BlockCodec::Method::lossy, tolerance);
+    std::vector<char> encoded = codec.encode(reinterpret_cast<const char *>(values.data()), values.size(), sizeof(double), 3, 900);
+    std::vector<char> bytes = codec.decode(encoded.data(), encoded.size(), sizeof(double), 3, 900);
+    std::vector<double> decoded(bytes.size() / sizeof(double));
+    std::memcpy(decoded.data(), bytes.data(), bytes.size());
+
+    ASSERT_EQ(decoded.size(), values.size());
+    for (std::size_t index = 0; index < values.size(); index++)
+        EXPECT_LE(std::fabs(decoded[index] - values[index]), tolerance * (1 + 1e-9));
+    EXPECT_LT(encoded.size(), sizeof(double) * values.size() / 4);
+    EXPECT_THROW(BlockCodec(BlockCodec::Method::lossy, 0.0), std::invalid_argument);
+};
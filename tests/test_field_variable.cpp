@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "../src/storage/field_variable.h"
+#include <algorithm>
+#include <cstdint>
 
 TEST(FieldVariable, Constructor){
     std::array<int,2> size = {3,3};	
@@ -40,4 +42,78 @@ TEST(FieldVariable, InterpolatAtYBorder){
     field(0,0) = -5.0;
     field(0,1) = 5.0;
     EXPECT_EQ(field.interpolateAt(0.0, 0.5), 0.0);
-};
\ No newline at end of file
+};
+
+TEST(FieldVariable, FloatStorage){
+    std::array<int,2> size = {2,2};
+    std::array<double,2> origin = {0.0, 0.0};
+    std::array<double,2> meshWidth = {1.0, 1.0};
+    FieldVariable<float> field(size, origin, meshWidth);
+    field(0,0) = -5.0f;
+    field(1,1) = 5.0f;
+    EXPECT_EQ(field.interpolateAt(0.5, 0.5), 0.0);
+    EXPECT_EQ(field.findAbsMax(), 5.0);
+};
+
+TEST(FieldVariable, InterpolateToNodesMatchesInterpolateAt){
+    // staggered like u, p and v: the nodes lie on the values, between two or between four of them
+    const std::array<int,2> size = {6,5};
+    const std::array<double,2> meshWidth = {0.5, 0.25};
+    const std::vector<std::array<double,2>> origins = {{0.0, -0.125}, {-0.25, -0.125}, {-0.25, 0.0}};
+    for (const std::array<double,2> &origin : origins)
+    {
+        FieldVariable field(size, origin, meshWidth);
+        for (int j = 0; j < size[1]; j++)
+            for (int i = 0; i < size[0]; i++)
+                field(i,j) = std::sin(i + 0.3 * j * j);
+
+        // nodes of the interior and the upper edges, as written by the output writers
+        const IndexRange nodes = {0, size[0] - 1, 0, size[1] - 1};
+        std::vector<double> values(2 * (size[0] - 1) * (size[1] - 1));
+        field.interpolateToNodes(nodes, values.data() + 1, 2);
+        for (int j = nodes.jBegin; j < nodes.jEnd; j++)
+            for (int i = nodes.iBegin; i < nodes.iEnd; i++)
+                EXPECT_NEAR(values[2 * (j * (size[0] - 1) + i) + 1], field.interpolateAt(i * meshWidth[0], j * meshWidth[1]), 1e-14);
+    }
+};
+
+TEST(FieldVariable, InterpolateToNodesInOutputPrecision){
+    FieldVariable field({6,5}, {-0.25, -0.125}, {0.5, 0.25});
+    for (int j = 0; j < 5; j++)
+        for (int i = 0; i < 6; i++)
+            field(i,j) = std::sin(i + 0.3 * j * j);
+
+    const IndexRange nodes = {0, 5, 0, 4};
+    std::vector<double> values(20);
+    std::vector<float> floats(20);
+    std::vector<std::uint16_t> quantized(20);
+    field.interpolateToNodes(nodes, values.data());
+    field.interpolateToNodes(nodes, floats.data());
+
+    // values in [-1, 1] in steps of 2 / 65535, values outside of the range are clamped
+    const double offset = -1.0, scale = 2.0 / 65535;
+    field.interpolateToNodes(nodes, quantized.data(), 1, offset, scale);
+    for (int index = 0; index < 20; index++)
+    {
+        EXPECT_EQ(floats[index], float(values[index]));
+        EXPECT_LE(std::abs(offset + scale * quantized[index] - values[index]), 0.5 * scale);
+    }
+    field.interpolateToNodes(nodes, quantized.data(), 1, 0.0, 1e-6);
+    EXPECT_EQ(*std::max_element(quantized.begin(), quantized.end()), 65535);
+    EXPECT_EQ(*std::min_element(quantized.begin(), quantized.end()), 0);
+};
+
+TEST(FieldVariable, InterpolateToNodesWithNodeStride){
+    FieldVariable field({8,7}, {-0.25, 0.0}, {0.5, 0.25});
+    for (int j = 0; j < 7; j++)
+        for (int i = 0; i < 8; i++)
+            field(i,j) = std::cos(0.7 * i - 0.2 * j);
+
+    // every third node of the nodes 1 to 6 in x and of 0 to 5 in y
+    std::vector<double> all(7 * 6), strided(2 * 2);
+    field.interpolateToNodes({0, 7, 0, 6}, all.data());
+    field.interpolateToNodes({1, 7, 0, 6}, strided.data(), 1, 0.0, 1.0, 3);
+    for (int j = 0; j < 2; j++)
+        for (int i = 0; i < 2; i++)
+            EXPECT_EQ(strided[j * 2 + i], all[3 * j * 7 + 1 + 3 * i]);
+};
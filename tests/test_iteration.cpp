@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "../src/storage/array2D.h"
+#include "../src/storage/iteration.h"
+
+TEST(Iteration, RowMajorTraversesRowByRow){
+    IndexRange range = {1,4,2,4};
+    std::vector<std::pair<int,int>> visited;
+    forEachInterior<RowMajorLayout>(range, [&](int i, int j){ visited.push_back({i,j}); });
+    std::vector<std::pair<int,int>> expected = {{1,2},{2,2},{3,2},{1,3},{2,3},{3,3}};
+    EXPECT_EQ(visited, expected);
+};
+
+TEST(Iteration, TiledTraversesTileByTile){
+    // tiles of 4x2 cells, the range touches the tiles [0,4)x[0,2), [4,8)x[0,2), [0,4)x[2,4) and [4,8)x[2,4)
+    IndexRange range = {3,6,1,4};
+    std::vector<std::pair<int,int>> visited;
+    forEachInterior<TiledLayout<4,2>>(range, [&](int i, int j){ visited.push_back({i,j}); });
+    std::vector<std::pair<int,int>> expected = {{3,1},{4,1},{5,1},{3,2},{3,3},{4,2},{5,2},{4,3},{5,3}};
+    EXPECT_EQ(visited, expected);
+};
+
+TEST(Iteration, TilingComputesAlignedTiles){
+    // the tiles of TiledTraversesTileByTile, cut to the range
+    Tiling tiling = tilingOf<TiledLayout<4,2>>({3,6,1,4}, IterationPolicy());
+    EXPECT_EQ(tiling.nTiles, 4);
+    IndexRange tile = tiling.tile(1);
+    EXPECT_EQ(tile.iBegin, 4);
+    EXPECT_EQ(tile.iEnd, 6);
+    EXPECT_EQ(tile.jBegin, 1);
+    EXPECT_EQ(tile.jEnd, 2);
+    tile = tiling.tile(2);
+    EXPECT_EQ(tile.iBegin, 3);
+    EXPECT_EQ(tile.iEnd, 4);
+    EXPECT_EQ(tile.jBegin, 2);
+    EXPECT_EQ(tile.jEnd, 4);
+
+    Tiling empty = tilingOf<TiledLayout<4,2>>({3,3,1,4}, IterationPolicy());
+    EXPECT_EQ(empty.nTiles, 0);
+};
+
+TEST(Iteration, UserTilesVisitEveryCellOnce){
+    IndexRange range = {1,12,1,10};
+    IterationPolicy policy;
+    policy.tileWidth = 4;
+    policy.tileHeight = 3;
+    std::vector<int> count(13 * 11, 0);
+    forEachInterior<RowMajorLayout>(range, [&](int i, int j){ count[j * 13 + i]++; }, policy);
+    for (int j = 0; j < 11; j++){
+        for (int i = 0; i < 13; i++){
+            bool inside = 1 <= i && i < 12 && 1 <= j && j < 10;
+            EXPECT_EQ(count[j * 13 + i], inside ? 1 : 0);
+        }
+    }
+};
+
+TEST(Iteration, ReduceIsIndependentOfTiling){
+    IndexRange range = {0,17,0,9};
+    auto value = [](int i, int j){ return i + 100 * j; };
+    int sum = reduceInterior<RowMajorLayout>(range, 0, value, std::plus<int>());
+    int tiledSum = reduceInterior<TiledLayout<>>(range, 0, value, std::plus<int>(), IterationPolicy::independent());
+    EXPECT_EQ(sum, 9 * (16 * 17 / 2) + 17 * 100 * (8 * 9 / 2));
+    EXPECT_EQ(tiledSum, sum);
+};
+
+TEST(Iteration, RowKernelSeesRowsOfCell){
+    // every cell of one colour gets the sum of its left and lower neighbour, read through the rows
+    std::array<int,2> size = {7,5};
+    Array2D<double, RowMajorLayout> a(size);
+    Array2D<double, RowMajorLayout> b(size);
+    for (int j = 0; j < 5; j++)
+        for (int i = 0; i < 7; i++)
+            a(i,j) = i + 100 * j;
+    const FieldView<const double, RowMajorLayout> from = std::as_const(a).view();
+    const FieldView<double, RowMajorLayout> to = b.view();
+    const int stride = from.stride();
+    forEachOfColour<RowMajorLayout>({1,6,1,4}, 0, onRows([=](int i, const double *fromRow, double *toRow)
+                                                         { toRow[i] = fromRow[i - 1] + fromRow[i - stride]; }, from, to),
+                                    IterationPolicy::independent());
+    for (int j = 0; j < 5; j++){
+        for (int i = 0; i < 7; i++){
+            bool visited = 1 <= i && i < 6 && 1 <= j && j < 4 && (i + j) % 2 == 0;
+            EXPECT_EQ(b(i,j), visited ? a(i - 1,j) + a(i,j - 1) : 0.0);
+        }
+    }
+};
+
+TEST(Iteration, StripAndInnerRangeCoverRangeOnce){
+    // ranges wider and narrower than two strips
+    for (IndexRange range : {IndexRange{1,9,2,7}, IndexRange{1,2,1,6}, IndexRange{0,3,0,3}}){
+        std::vector<int> count(10 * 10, 0);
+        auto visit = [&](int i, int j){ count[j * 10 + i]++; };
+        forEachInterior<RowMajorLayout>(innerRange(range, 1), visit);
+        for (const IndexRange &strip : boundaryStrips(range, 1))
+            forEachInterior<RowMajorLayout>(strip, visit);
+        for (int j = 0; j < 10; j++){
+            for (int i = 0; i < 10; i++){
+                bool inside = range.iBegin <= i && i < range.iEnd && range.jBegin <= j && j < range.jEnd;
+                EXPECT_EQ(count[j * 10 + i], inside ? 1 : 0);
+            }
+        }
+    }
+
+    IndexRange inner = innerRange({1,9,2,7}, 1);
+    EXPECT_EQ(inner.iBegin, 2);
+    EXPECT_EQ(inner.iEnd, 8);
+    EXPECT_EQ(inner.jBegin, 3);
+    EXPECT_EQ(inner.jEnd, 6);
+};
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include "../src/output_writer/node_selection.h"
+
+TEST(NodeSelection, WholeDomainByDefault){
+    Partitioning partitioning({20, 10});
+    NodeSelection selection(partitioning, {0.1, 0.2});
+
+    EXPECT_FALSE(selection.isEmpty());
+    EXPECT_EQ(selection.wholeExtent(), (std::array<int,4>{0, 20, 0, 10}));
+    EXPECT_EQ(selection.extent(), selection.wholeExtent());
+    EXPECT_EQ(selection.origin(), (std::array<double,2>{0.0, 0.0}));
+    EXPECT_EQ(selection.rows(0, 11).iEnd, 21);
+    EXPECT_EQ(selection.rows(0, 11).jEnd, 11);
+};
+
+TEST(NodeSelection, RegionAndStride){
+    Partitioning partitioning({20, 10});
+
+    // nodes 3 to 10 in x and 3 to 9 in y lie in the box, every second one from the lower left one is selected
+    NodeSelection selection(partitioning, {0.1, 0.1}, {0.25, 0.3, 1.0, 0.95}, 2);
+    EXPECT_EQ(selection.wholeExtent(), (std::array<int,4>{0, 3, 0, 3}));
+    EXPECT_EQ(selection.nPoints(), (std::array<int,2>{4, 4}));
+    EXPECT_NEAR(selection.origin()[0], 0.3, 1e-12);
+    EXPECT_NEAR(selection.origin()[1], 0.3, 1e-12);
+    EXPECT_NEAR(selection.spacing()[0], 0.2, 1e-12);
+
+    const IndexRange rows = selection.rows(1, 3);
+    EXPECT_EQ(rows.iBegin, 3);
+    EXPECT_EQ(rows.iEnd, 10);
+    EXPECT_EQ(rows.jBegin, 5);
+    EXPECT_EQ(rows.jEnd, 8);
+
+    EXPECT_THROW(NodeSelection(partitioning, {0.1, 0.1}, {0.31, 0.0, 0.39, 1.0}), std::invalid_argument);
+    EXPECT_THROW(NodeSelection(partitioning, {0.1, 0.1}, {}, 0), std::invalid_argument);
+};
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "../src/output_writer/output_schedule.h"
+
+TEST(OutputSchedule, StepIntervalAndTimes){
+    OutputCadence cadence;
+    cadence.stepInterval = 3;
+    cadence.times = {0.25, 0.3};
+    OutputSchedule schedule(cadence);
+    EXPECT_TRUE(schedule.isEnabled());
+
+    EXPECT_FALSE(schedule.isDue(0.1, 1, false));
+    EXPECT_FALSE(schedule.isDue(0.2, 2, false));
+    EXPECT_TRUE(schedule.isDue(0.24, 3, false));
+
+    // both explicit times are passed by one step, a single output
+    EXPECT_TRUE(schedule.isDue(0.35, 4, false));
+    EXPECT_FALSE(schedule.isDue(0.5, 5, false));
+    EXPECT_FALSE(OutputSchedule().isEnabled());
+};
+
+TEST(OutputSchedule, IntervalHitsOutputTimes){
+    OutputCadence cadence;
+    cadence.interval = 0.5;
+    OutputSchedule schedule(cadence);
+
+    // a time step that passes the output time is shortened, one that ends on it within rounding is kept
+    EXPECT_DOUBLE_EQ(schedule.clampTimeStepWidth(0.4, 0.3), 0.1);
+    EXPECT_DOUBLE_EQ(schedule.clampTimeStepWidth(0.45, 0.05 + 1e-14), 0.05 + 1e-14);
+    EXPECT_DOUBLE_EQ(schedule.clampTimeStepWidth(0.1, 0.2), 0.2);
+
+    double currentTime = 0;
+    int nOutputs = 0;
+    for (int stepNo = 1; stepNo <= 20; stepNo++)
+    {
+        currentTime += 0.05;
+        nOutputs += schedule.isDue(currentTime, stepNo, false);
+    }
+    EXPECT_EQ(nOutputs, 2);
+};
+
+TEST(OutputSchedule, OnceWhenSteady){
+    OutputCadence cadence;
+    cadence.onSteadyState = true;
+    OutputSchedule schedule(cadence);
+
+    EXPECT_FALSE(schedule.isDue(1, 1, false));
+    EXPECT_TRUE(schedule.isDue(2, 2, true));
+    EXPECT_FALSE(schedule.isDue(3, 3, true));
+    EXPECT_FALSE(schedule.isDue(4, 4, false));
+    EXPECT_TRUE(schedule.isDue(5, 5, true));
+};
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "../src/parallel/partitioning.h"
+
+TEST(Partitioning, SerialOwnsWholeDomain){
+    Partitioning partitioning({20, 10});
+
+    EXPECT_EQ(partitioning.nCellsLocal()[0], 20);
+    EXPECT_EQ(partitioning.nCellsLocal()[1], 10);
+    EXPECT_EQ(partitioning.nodeOffset()[0], 0);
+    EXPECT_EQ(partitioning.nodeOffset()[1], 0);
+    EXPECT_TRUE(partitioning.ownPartitionContainsLeftBoundary());
+    EXPECT_TRUE(partitioning.ownPartitionContainsRightBoundary());
+    EXPECT_TRUE(partitioning.ownPartitionContainsBottomBoundary());
+    EXPECT_TRUE(partitioning.ownPartitionContainsTopBoundary());
+    EXPECT_EQ(partitioning.leftNeighbourRankNo(), MPI_PROC_NULL);
+    EXPECT_EQ(partitioning.topNeighbourRankNo(), MPI_PROC_NULL);
+};
+
+TEST(Partitioning, ProcessGridMinimizesInterfaces){
+    // a long channel is cut into slices across the short side
+    std::array<int,2> grid = Partitioning::chooseProcessGrid(4, {100, 20});
+    EXPECT_EQ(grid[0], 4);
+    EXPECT_EQ(grid[1], 1);
+
+    grid = Partitioning::chooseProcessGrid(4, {20, 100});
+    EXPECT_EQ(grid[0], 1);
+    EXPECT_EQ(grid[1], 4);
+
+    // a square domain is cut into squares
+    grid = Partitioning::chooseProcessGrid(4, {64, 64});
+    EXPECT_EQ(grid[0], 2);
+    EXPECT_EQ(grid[1], 2);
+
+    // ties are resolved in favour of the proposal
+    grid = Partitioning::chooseProcessGrid(2, {10, 10}, {1, 2});
+    EXPECT_EQ(grid[0], 1);
+    EXPECT_EQ(grid[1], 2);
+
+    // every subdomain keeps at least one cell
+    grid = Partitioning::chooseProcessGrid(6, {3, 100});
+    EXPECT_LE(grid[0], 3);
+    EXPECT_EQ(grid[0] * grid[1], 6);
+
+    // more ranks than cells
+    EXPECT_THROW(Partitioning::chooseProcessGrid(7, {2, 3}), std::invalid_argument);
+};
+
+TEST(Partitioning, RemainderIsSpreadOverFirstSubdomains){
+    const int nCells = 10;
+    const int nSubdomains = 4;
+
+    int nCellsTotal = 0;
+    for (int coordinate = 0; coordinate < nSubdomains; coordinate++)
+    {
+        const int nCellsLocal = Partitioning::nCellsOfSubdomain(nCells, nSubdomains, coordinate);
+        EXPECT_EQ(Partitioning::offsetOfSubdomain(nCells, nSubdomains, coordinate), nCellsTotal);
+        EXPECT_GE(nCellsLocal, 2);
+        EXPECT_LE(nCellsLocal, 3);
+        nCellsTotal += nCellsLocal;
+    }
+    EXPECT_EQ(nCellsTotal, nCells);
+    EXPECT_EQ(Partitioning::nCellsOfSubdomain(nCells, nSubdomains, 0), 3);
+    EXPECT_EQ(Partitioning::nCellsOfSubdomain(nCells, nSubdomains, 3), 2);
+};
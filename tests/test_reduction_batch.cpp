@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include "../src/parallel/reduction_batch.h"
+
+TEST(ReductionBatch, SerialKeepsLocalValues){
+    auto partitioning = std::make_shared<Partitioning>(std::array<int,2>{8, 8});
+    ReductionBatch batch(partitioning);
+
+    int sum = batch.add(1.5, ReductionBatch::Operation::sum);
+    int max = batch.add(-2.0, ReductionBatch::Operation::max);
+    batch.reduce();
+    EXPECT_EQ(sum, 0);
+    EXPECT_EQ(max, 1);
+    EXPECT_DOUBLE_EQ(batch.value(sum), 1.5);
+    EXPECT_DOUBLE_EQ(batch.value(max), -2.0);
+
+    // the next sync point starts with an empty batch
+    batch.clear();
+    int min = batch.add(3.0, ReductionBatch::Operation::min);
+    batch.begin();
+    batch.finish();
+    EXPECT_EQ(min, 0);
+    EXPECT_DOUBLE_EQ(batch.value(min), 3.0);
+};
@@ -40,6 +40,19 @@ TEST(StaggeredGrid, MinimalGrid){
     EXPECT_EQ(grids.p().interpolateAt(-0.5, -0.5), 1.0);
 };
 
+TEST(StaggeredGrid, SnapshotWithoutIntermediates){
+    // a snapshot of the output stores only u, v and p in full size
+    std::array<int,2> n_cells = {4, 3};
+    std::array<double,2> meshWidth = {0.5, 0.5};
+    StaggeredGrid grids(n_cells, meshWidth, nullptr, false);
+
+    EXPECT_EQ(grids.u().size()[0], 6);
+    EXPECT_EQ(grids.v().size()[1], 5);
+    EXPECT_EQ(grids.p().size()[0], 6);
+    EXPECT_EQ(grids.f().size()[0] * grids.f().size()[1], 1);
+    EXPECT_EQ(grids.g().size()[0] * grids.g().size()[1], 1);
+    EXPECT_EQ(grids.rhs().size()[0] * grids.rhs().size()[1], 1);
+};
 
 TEST(StaggeredGrid, LargeGrid){
     int N = 1000;
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "../src/parallel/task_graph.h"
+
+#include <array>
+#include <atomic>
+
+TEST(TaskGraph, TasksStartAfterTheirDependencies){
+    // independent tasks may run at the same time, every task draws the number of its completion
+    std::atomic<int> nFinished(0);
+    std::array<int, 4> position;
+    auto task = [&](int taskNo){ return [&, taskNo](){ position[taskNo] = nFinished++; }; };
+    TaskGraph graph;
+    int first = graph.add(task(0));
+    int second = graph.add(task(1), {first});
+    int third = graph.add(task(2));
+    graph.add(task(3), {second, third});
+    EXPECT_EQ(graph.size(), 4);
+
+    graph.run();
+    ASSERT_EQ(nFinished, 4);
+    EXPECT_LT(position[0], position[1]);
+    EXPECT_LT(position[1], position[3]);
+    EXPECT_LT(position[2], position[3]);
+
+    // the graph can be run again
+    nFinished = 0;
+    graph.run();
+    EXPECT_EQ(nFinished, 4);
+};
+
+TEST(TaskGraph, TilesCoverRangeOnce){
+    std::vector<int> visits(12 * 9, 0);
+    auto visit = [&](int i, int j){ visits[j * 12 + i]++; };
+
+    IterationPolicy policy = IterationPolicy::independent();
+    policy.tileWidth = 5;
+    policy.tileHeight = 4;
+    TaskGraph graph;
+    std::vector<int> tiles = graph.addForEach({1, 11, 1, 8}, visit, {}, policy);
+    EXPECT_EQ(tiles.size(), 6u);
+    graph.run();
+
+    for (int j = 0; j < 9; j++)
+        for (int i = 0; i < 12; i++)
+            EXPECT_EQ(visits[j * 12 + i], (i >= 1 && i < 11 && j >= 1 && j < 8) ? 1 : 0);
+};
@@ -0,0 +1,18 @@
+#include <gtest/gtest.h>
+#include "../src/parallel/thread_pool.h"
+
+TEST(ThreadPool, CacheSizedTileFitsIntoCaches){
+    // 4 double field variables per cell, 48 KiB L1 and 2 MiB L2
+    const int bytesPerCell = 32;
+    std::array<int,2> tile = ThreadPool::cacheSizedTile(bytesPerCell, 48 * 1024, 2 * 1024 * 1024);
+
+    EXPECT_EQ(tile[0] % 16, 0);
+    EXPECT_LE(3 * tile[0] * bytesPerCell, 48 * 1024);
+    EXPECT_LE(tile[0] * tile[1] * bytesPerCell, 1024 * 1024);
+    EXPECT_GT(2 * tile[0] * tile[1] * bytesPerCell, 1024 * 1024 / 2);
+
+    // tiny caches still give usable tiles
+    tile = ThreadPool::cacheSizedTile(bytesPerCell, 1024, 1024);
+    EXPECT_EQ(tile[0], 16);
+    EXPECT_EQ(tile[1], 1);
+};
@@ -0,0 +1,201 @@
+"""Convert compressed vti pieces of the simulation to uncompressed vti files.
+
+The pieces written with paraviewCompression = shuffle or lossy use compressors that
+ParaView does not know (numsimShuffleLZ4, numsimLossyLZ4), pieces written with lz4
+(vtkLZ4DataCompressor) are read by ParaView directly but can be converted as well.
+The arrays are decoded like BlockCodec::decode in src/output_writer/block_codec.cpp
+and written as raw appended arrays of the same type (Float64, Float32 or UInt16),
+the pvti files stay valid. Quantized UInt16 values are value = offset + scale * stored
+with offset and scale in the field data <array>_quantization.
+
+Usage:
+    python3 decode_vti.py out/output_0010.0.vti [more files ...] [-o directory]
+
+Without -o, every file is replaced by its uncompressed version. Only the Python
+standard library is needed.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+
+def decompress_lz4(data, decompressed_size=None):
+    """Decompress an LZ4 block without frame, the size is checked if it is known."""
+    out = bytearray()
+    position = 0
+    size = len(data)
+    while position < size:
+        token = data[position]
+        position += 1
+        literal_length = token >> 4
+        if literal_length == 15:
+            while True:
+                byte = data[position]
+                position += 1
+                literal_length += byte
+                if byte != 255:
+                    break
+        out += data[position:position + literal_length]
+        position += literal_length
+        if position >= size:
+            break
+
+        offset = data[position] | (data[position + 1] << 8)
+        position += 2
+        match_length = token & 15
+        if match_length == 15:
+            while True:
+                byte = data[position]
+                position += 1
+                match_length += byte
+                if byte != 255:
+                    break
+        match_length += 4
+
+        # the match may overlap the bytes it produces
+        start = len(out) - offset
+        if offset >= match_length:
+            out += out[start:start + match_length]
+        else:
+            for index in range(match_length):
+                out.append(out[start + index])
+    if decompressed_size is not None and len(out) != decompressed_size:
+        raise ValueError("corrupt LZ4 block")
+    return bytes(out)
+
+
+def predict(multiples, k, n_components, row_length):
+    """Prediction of a multiple from the previous node and the two nodes below, in the block."""
+    if k >= row_length + n_components:
+        return multiples[k - n_components] + multiples[k - row_length] - multiples[k - row_length - n_components]
+    if k >= n_components:
+        return multiples[k - n_components]
+    return 0
+
+
+VALUE_SIZES = {"Float64": 8, "Float32": 4, "UInt16": 2}
+
+
+def decode_block(compressor, data, n_values, value_size, n_components, row_length, tolerance):
+    """Decode one block to the raw bytes of its values."""
+    if compressor == "vtkLZ4DataCompressor":
+        return decompress_lz4(data, value_size * n_values)
+
+    if compressor == "numsimShuffleLZ4":
+        shuffled = decompress_lz4(data, value_size * n_values)
+        raw = bytearray(value_size * n_values)
+        position = 0
+        for component in range(n_components):
+            n_component_values = len(range(component, n_values, n_components))
+            for byte_no in range(value_size):
+                start = value_size * component + byte_no
+                raw[start::value_size * n_components] = shuffled[position:position + n_component_values]
+                position += n_component_values
+        return bytes(raw)
+
+    if compressor == "numsimLossyLZ4":
+        residuals = decompress_lz4(data)
+        multiples = []
+        position = 0
+        for k in range(n_values):
+            zigzag = 0
+            shift = 0
+            while True:
+                byte = residuals[position]
+                position += 1
+                zigzag |= (byte & 0x7F) << shift
+                shift += 7
+                if byte < 0x80:
+                    break
+            residual = (zigzag >> 1) ^ -(zigzag & 1)
+            multiples.append(residual + predict(multiples, k, n_components, row_length))
+        return struct.pack("<%dd" % n_values, *[multiple * (2 * tolerance) for multiple in multiples])
+
+    raise ValueError("unknown compressor " + compressor)
+
+
+def decode_array(compressor, data, offset, value_size, n_components, row_length, tolerance):
+    """Decode the encoded array at offset in the appended data, the header of UInt64 sizes is followed by the blocks."""
+    n_blocks, block_size, last_block_size = struct.unpack_from("<3Q", data, offset)
+    block_sizes = struct.unpack_from("<%dQ" % n_blocks, data, offset + 24)
+    if last_block_size == 0:
+        last_block_size = block_size
+
+    raw = bytearray()
+    position = offset + 24 + 8 * n_blocks
+    for block_no, size in enumerate(block_sizes):
+        n_bytes = last_block_size if block_no == n_blocks - 1 else block_size
+        raw += decode_block(compressor, data[position:position + size], n_bytes // value_size, value_size,
+                            n_components, row_length, tolerance)
+        position += size
+    return bytes(raw)
+
+
+def decode_file(input_name, output_name):
+    with open(input_name, "rb") as file:
+        content = file.read()
+
+    start = content.index(b'<AppendedData encoding="raw">')
+    data_start = content.index(b"_", start) + 1
+    data_end = content.rindex(b"</AppendedData>")
+    header = content[:data_start].decode()
+    data = content[data_start:data_end]
+
+    compressor = re.search(r'compressor="([^"]*)"', header)
+    if compressor is None:
+        print(input_name + " is not compressed")
+        if output_name != input_name:
+            with open(output_name, "wb") as file:
+                file.write(content)
+        return
+    compressor = compressor.group(1)
+    tolerance = re.search(r'tolerance="([^"]*)"', header)
+    tolerance = float(tolerance.group(1)) if tolerance else 0.0
+
+    extent = [int(value) for value in re.search(r'<Piece Extent="([^"]*)"', header).group(1).split()]
+    n_points_x = extent[1] - extent[0] + 1
+
+    # decode the arrays and write them with their sizes, the offsets in the header change accordingly
+    appended = bytearray()
+    array_pattern = re.compile(r'(<DataArray [^>]*format="appended" offset=")(\d+)("/>)')
+    new_header = []
+    last_end = 0
+    for match in array_pattern.finditer(header):
+        n_components = int(re.search(r'NumberOfComponents="(\d+)"', match.group(0)).group(1))
+        value_size = VALUE_SIZES[re.search(r'type="(\w+)"', match.group(0)).group(1)]
+        raw = decode_array(compressor, data, int(match.group(2)), value_size, n_components, n_components * n_points_x,
+                           tolerance)
+        new_header.append(header[last_end:match.start()])
+        new_header.append(match.group(1) + str(len(appended)) + match.group(3))
+        appended += struct.pack("<Q", len(raw)) + raw
+        last_end = match.end()
+    new_header.append(header[last_end:])
+    new_header = "".join(new_header)
+    new_header = re.sub(r' compressor="[^"]*"', "", new_header)
+    new_header = re.sub(r' tolerance="[^"]*"', "", new_header)
+
+    with open(output_name, "wb") as file:
+        file.write(new_header.encode())
+        file.write(appended)
+        file.write(b"\n  " + content[data_end:])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert compressed vti pieces to uncompressed vti files.")
+    parser.add_argument("files", nargs="+", help="compressed *.vti files")
+    parser.add_argument("-o", "--output", help="directory of the uncompressed files, by default the files are replaced")
+    arguments = parser.parse_args()
+
+    for input_name in arguments.files:
+        output_name = input_name
+        if arguments.output:
+            os.makedirs(arguments.output, exist_ok=True)
+            output_name = os.path.join(arguments.output, os.path.basename(input_name))
+        decode_file(input_name, output_name)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,198 @@
+"""Extract frames of the stream out/output.stream of the simulation as vti files.
+
+The stream is written with paraviewOutput = stream by OutputWriterStream in
+src/output_writer/output_writer_stream.h: a text header, then the frames. Every
+keyframeInterval-th frame contains the values at the nodes, the others the values
+XOR the values of the previous frame, both encoded like the numsimShuffleLZ4 arrays
+of the vti pieces. The index out/output.stream.index gives the offset of every frame,
+a frame is reconstructed from the last keyframe before it and the frames in between.
+
+Every extracted frame is written as one uncompressed vti file output_<frame>.vti of
+the whole selected mesh, with the values in the precision of the stream.
+
+Usage:
+    python3 extract_stream.py out/output.stream [-f 0 17 42] [-o directory]
+
+Without -f, all frames are extracted, the files are written to the directory of
+the stream unless -o is given. Only the Python standard library is needed.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from decode_vti import VALUE_SIZES, decode_array
+
+FRAME_HEADER_SIZE = 48
+
+
+def read_header(content):
+    """Parse the text header, returns its values and the offset of the first frame."""
+    end = content.index(b"\nframes\n") + len(b"\nframes\n")
+    lines = content[:end].decode().splitlines()
+    if lines[0] != "numsim stream 1":
+        raise ValueError("not a numsim stream")
+
+    header = {}
+    line_no = 1
+    while lines[line_no] != "frames":
+        words = lines[line_no].split()
+        line_no += 1
+        if words[0] == "pieces":
+            header["pieces"] = [[int(word) for word in lines[line_no + piece_no].split()] for piece_no in range(int(words[1]))]
+            line_no += int(words[1])
+        elif words[0] == "arrays":
+            header["arrays"] = [(words[k], int(words[k + 1])) for k in range(1, len(words), 2)]
+        elif words[0] == "precision":
+            header["precision"] = words[1]
+        elif words[0] in ("origin", "spacing"):
+            header[words[0]] = [float(word) for word in words[1:]]
+        else:
+            header[words[0]] = [int(word) for word in words[1:]]
+    return header, end
+
+
+def read_index(file_name):
+    """Frames of the index: frame number, time, if it is a keyframe, offset and size."""
+    frames = []
+    with open(file_name) as file:
+        next(file)
+        for line in file:
+            frame_no, time, keyframe, offset, size = [word.strip() for word in line.split(",")]
+            frames.append((int(frame_no), float(time), keyframe == "1", int(offset), int(size)))
+    return frames
+
+
+def decode_frame(content, header, offset):
+    """Decode the frame at offset, returns time, if it is a keyframe, quantization and the arrays of every piece."""
+    time, keyframe = struct.unpack_from("<dQ", content, offset)
+    quantization = struct.unpack_from("<4d", content, offset + 16)
+    value_size = VALUE_SIZES[header["precision"]]
+
+    pieces = []
+    position = offset + FRAME_HEADER_SIZE
+    for extent in header["pieces"]:
+        n_points_x = extent[1] - extent[0] + 1
+        sizes = struct.unpack_from("<2Q", content, position)
+        position += 16
+        arrays = []
+        for (name, n_components), size in zip(header["arrays"], sizes):
+            arrays.append(decode_array("numsimShuffleLZ4", content, position, value_size, n_components,
+                                       n_components * n_points_x, 0.0))
+            position += size
+        pieces.append(arrays)
+    return time, keyframe == 1, quantization, pieces
+
+
+def xor(a, b):
+    """Bytes a XOR b of the same length."""
+    return (int.from_bytes(a, "little") ^ int.from_bytes(b, "little")).to_bytes(len(a), "little")
+
+
+def reconstruct(content, header, frames, frame_no, previous=None):
+    """Values of all pieces of a frame, from the last keyframe before it or from a previous frame (number, pieces) after it."""
+    first = frame_no
+    while not frames[first][2]:
+        first -= 1
+
+    pieces = None
+    if previous is not None and first <= previous[0] < frame_no:
+        first = previous[0] + 1
+        pieces = previous[1]
+    for frame in frames[first:frame_no + 1]:
+        time, keyframe, quantization, frame_pieces = decode_frame(content, header, frame[3])
+        if keyframe:
+            pieces = frame_pieces
+        else:
+            pieces = [[xor(array, difference) for array, difference in zip(piece, differences)]
+                      for piece, differences in zip(pieces, frame_pieces)]
+    return time, quantization, pieces
+
+
+def assemble(header, pieces, array_no, n_components, value_size):
+    """Values of an array of the whole mesh from the pieces, row by row."""
+    whole_extent = header["wholeExtent"]
+    n_points_x = whole_extent[1] - whole_extent[0] + 1
+    n_points_y = whole_extent[3] - whole_extent[2] + 1
+    row_size = n_components * value_size
+    whole = bytearray(row_size * n_points_x * n_points_y)
+    for extent, piece in zip(header["pieces"], pieces):
+        piece_row_size = row_size * (extent[1] - extent[0] + 1)
+        for j in range(extent[2], extent[3] + 1):
+            start = row_size * (j * n_points_x + extent[0])
+            piece_start = piece_row_size * (j - extent[2])
+            whole[start:start + piece_row_size] = piece[array_no][piece_start:piece_start + piece_row_size]
+    return bytes(whole)
+
+
+def write_vti(file_name, header, time, quantization, arrays):
+    """Write an uncompressed vti file like VtiFile in src/output_writer/vti_file.h."""
+    extent = " ".join(str(value) for value in header["wholeExtent"]) + " 0 0"
+    origin = header["origin"]
+    spacing = header["spacing"]
+    precision = header["precision"]
+
+    text = ['<?xml version="1.0"?>\n',
+            '<VTKFile type="ImageData" version="1.0" byte_order="LittleEndian" header_type="UInt64">\n',
+            '  <ImageData WholeExtent="%s" Origin="%.17g %.17g 0" Spacing="%.17g %.17g 1">\n' % (extent, origin[0], origin[1],
+                                                                                  spacing[0], spacing[1]),
+            '    <FieldData>\n',
+            '      <DataArray type="Float64" Name="TIME" NumberOfTuples="1" format="ascii">%.17g</DataArray>\n' % time]
+    if precision == "UInt16":
+        for array_no, (name, n_components) in enumerate(header["arrays"]):
+            text.append('      <DataArray type="Float64" Name="%s_quantization" NumberOfComponents="2" NumberOfTuples="1"'
+                        ' format="ascii">%.17g %.17g</DataArray>\n' % (name, quantization[2 * array_no],
+                                                                quantization[2 * array_no + 1]))
+    text += ['    </FieldData>\n',
+             '    <Piece Extent="%s">\n' % extent,
+             '      <PointData>\n']
+    offset = 0
+    for (name, n_components), values in zip(header["arrays"], arrays):
+        text.append('        <DataArray type="%s" Name="%s" NumberOfComponents="%d" format="appended" offset="%d"/>\n'
+                    % (precision, name, n_components, offset))
+        offset += 8 + len(values)
+    text += ['      </PointData>\n',
+             '    </Piece>\n',
+             '  </ImageData>\n',
+             '  <AppendedData encoding="raw">\n',
+             '   _']
+
+    with open(file_name, "wb") as file:
+        file.write("".join(text).encode())
+        for values in arrays:
+            file.write(struct.pack("<Q", len(values)) + values)
+        file.write(b"\n  </AppendedData>\n</VTKFile>\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Extract frames of a numsim stream as vti files.")
+    parser.add_argument("stream", help="the stream, e.g. out/output.stream, the index is <stream>.index")
+    parser.add_argument("-f", "--frames", type=int, nargs="+", help="numbers of the frames, by default all")
+    parser.add_argument("-o", "--output", help="directory of the vti files, by default the one of the stream")
+    arguments = parser.parse_args()
+
+    with open(arguments.stream, "rb") as file:
+        content = file.read()
+    header, _ = read_header(content)
+    frames = read_index(arguments.stream + ".index")
+
+    directory = arguments.output or os.path.dirname(arguments.stream)
+    if directory:
+        os.makedirs(directory, exist_ok=True)
+    value_size = VALUE_SIZES[header["precision"]]
+    frame_nos = arguments.frames if arguments.frames is not None else range(len(frames))
+    previous = None
+    for frame_no in frame_nos:
+        if not 0 <= frame_no < len(frames):
+            print("The stream has no frame %d." % frame_no)
+            return 1
+        time, quantization, pieces = reconstruct(content, header, frames, frame_no, previous)
+        previous = (frame_no, pieces)
+        arrays = [assemble(header, pieces, array_no, n_components, value_size)
+                  for array_no, (name, n_components) in enumerate(header["arrays"])]
+        write_vti(os.path.join(directory, "output_%04d.vti" % frame_no), header, time, quantization, arrays)
+
+
+if __name__ == "__main__":
+    sys.exit(main())